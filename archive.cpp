@@ -0,0 +1,421 @@
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#include "archive.hpp"
+#include "engine.hpp"
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+
+
+/* Bits appended to a byte vector, LSB first */
+struct BitWriter {
+	std::vector<uint8_t> *data;
+
+	uint64_t bits;
+	int count;	// Bits held, fewer than 8 between writes
+};
+
+/* Bits read from a byte array, LSB first */
+struct BitReader {
+	const uint8_t *next;
+
+	uint64_t bits;
+	int count;
+};
+
+// Encoding Functions
+
+static uint64_t zigzag(int64_t value) {
+	return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+static int64_t unzigzag(uint64_t value) {
+	return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+static void putVarint(std::vector<uint8_t> *data, uint64_t value) {
+
+	while (value >= 0x80) {
+		data->push_back((uint8_t)(value | 0x80));
+		value >>= 7;
+	}
+
+	data->push_back((uint8_t)value);
+}
+
+static uint64_t getVarint(const uint8_t **next) {
+
+	uint64_t value = 0;
+	int shift = 0;
+
+	while (**next & 0x80) {
+		value |= (uint64_t)(**next & 0x7f) << shift;
+		shift += 7;
+		(*next)++;
+	}
+
+	value |= (uint64_t)**next << shift;
+	(*next)++;
+
+	return value;
+}
+
+static void putBits(BitWriter *writer, uint64_t value, int width) {
+
+	writer->bits |= value << writer->count;
+	writer->count += width;
+
+	while (writer->count >= 8) {
+		writer->data->push_back((uint8_t)writer->bits);
+		writer->bits >>= 8;
+		writer->count -= 8;
+	}
+}
+
+static void flushBits(BitWriter *writer) {
+	if (writer->count > 0) writer->data->push_back((uint8_t)writer->bits);
+
+	writer->bits = 0;
+	writer->count = 0;
+}
+
+static uint64_t getBits(BitReader *reader, int width) {
+
+	while (reader->count < width) {
+		reader->bits |= (uint64_t)*reader->next++ << reader->count;
+		reader->count += 8;
+	}
+
+	uint64_t value = reader->bits & (((uint64_t)1 << width) - 1);
+
+	reader->bits >>= width;
+	reader->count -= width;
+
+	return value;
+}
+
+/* Bits needed to hold value */
+static int bitWidth(uint64_t value) {
+
+	int width = 0;
+
+	while (value > 0) {
+		width++;
+		value >>= 1;
+	}
+
+	return width;
+}
+
+// Archive Functions
+
+uint32_t EventArchive::idHandle(std::string id) {
+
+	auto found = idHandles.find(id);
+
+	if (found != idHandles.end()) return found->second;
+
+	uint32_t handle = ids.size();
+
+	ids.push_back(id);
+	idHandles[id] = handle;
+
+	return handle;
+}
+
+int EventArchive::addGame(Game *game) {
+
+	std::vector<Event> events = game->getGameEvents();
+
+	ArchivedGame archived;
+
+	archived.gameID = game->getGameID();
+	archived.eventCount = events.size();
+
+	// Dictionary codes in order of first use within the Game
+	std::unordered_map<uint32_t, int> codes;
+
+	auto dictionaryCode = [this, &archived, &codes](std::string id) {
+
+		uint32_t handle = idHandle(id);
+
+		auto found = codes.find(handle);
+
+		if (found != codes.end()) return found->second;
+
+		int code = archived.dictionary.size();
+
+		archived.dictionary.push_back(handle);
+		codes[handle] = code;
+
+		return code;
+	};
+
+	std::vector<int64_t> values[ARCHIVE_FIELDS];
+
+	for (int first = 0; first < events.size(); first += ARCHIVE_BLOCK_EVENTS) {
+
+		int count = std::min((int)events.size() - first, ARCHIVE_BLOCK_EVENTS);
+
+		for (int f = 0; f < ARCHIVE_FIELDS; f++) values[f].resize(count);
+
+		for (int i = 0; i < count; i++) {
+
+			Event ev = events[first + i];
+			Event last = events[first + (i > 0 ? i - 1 : 0)];
+
+			values[ARCHIVE_EVENT_NUMBER][i] = (int64_t)ev.getEventNumber() -
+				last.getEventNumber();
+			values[ARCHIVE_EVENT_TYPE][i] = ev.getEventType();
+			values[ARCHIVE_PERIOD][i] = ev.getPeriod();
+			values[ARCHIVE_ACTION_TYPE][i] = ev.getActionType();
+			values[ARCHIVE_WC_TIME][i] = (int64_t)ev.getWCTime() -
+				last.getWCTime();
+			values[ARCHIVE_PC_TIME][i] = (int64_t)ev.getPCTime() -
+				last.getPCTime();
+			values[ARCHIVE_OPTION1][i] = ev.getOption();
+			values[ARCHIVE_PLAYER1][i] =
+				dictionaryCode(ev.getPlayer1().getPlayerID());
+			values[ARCHIVE_PLAYER2][i] =
+				dictionaryCode(ev.getPlayer2().getPlayerID());
+			values[ARCHIVE_PLAYER3][i] =
+				dictionaryCode(ev.getPlayer3().getPlayerID());
+			values[ARCHIVE_TEAM][i] = dictionaryCode(ev.getTeam().getTeamID());
+		}
+
+		archived.blockOffsets.push_back(archived.data.size());
+
+		putVarint(&archived.data, count);
+		putVarint(&archived.data, zigzag(events[first].getEventNumber()));
+		putVarint(&archived.data, zigzag(events[first].getWCTime()));
+		putVarint(&archived.data, zigzag(events[first].getPCTime()));
+
+		int64_t minimum[ARCHIVE_FIELDS];
+		int width[ARCHIVE_FIELDS];
+
+		for (int f = 0; f < ARCHIVE_FIELDS; f++) {
+
+			int64_t low = values[f][0], high = values[f][0];
+
+			for (int64_t value : values[f]) {
+				low = std::min(low, value);
+				high = std::max(high, value);
+			}
+
+			minimum[f] = low;
+			width[f] = bitWidth((uint64_t)(high - low));
+
+			putVarint(&archived.data, zigzag(low));
+			archived.data.push_back((uint8_t)width[f]);
+		}
+
+		BitWriter writer = { &archived.data, 0, 0 };
+
+		for (int f = 0; f < ARCHIVE_FIELDS; f++) {
+			for (int64_t value : values[f]) {
+				putBits(&writer, (uint64_t)(value - minimum[f]), width[f]);
+			}
+		}
+
+		flushBits(&writer);
+	}
+
+	archived.data.shrink_to_fit();
+
+	games.push_back(archived);
+
+	return games.size() - 1;
+}
+
+int EventArchive::getGameCount() {
+	return games.size();
+}
+
+int EventArchive::getBlockCount(int g) {
+	return games[g].blockOffsets.size();
+}
+
+int EventArchive::getEventCount(int g) {
+	return games[g].eventCount;
+}
+
+std::string EventArchive::getGameID(int g) {
+	return games[g].gameID;
+}
+
+int EventArchive::decodeBlock(int g, int b, std::vector<Event> *scratch) {
+
+	ArchivedGame *archived = &games[g];
+
+	const uint8_t *next = archived->data.data() + archived->blockOffsets[b];
+
+	int count = getVarint(&next);
+
+	int64_t eventNumber = unzigzag(getVarint(&next));
+	int64_t wcTime = unzigzag(getVarint(&next));
+	int64_t pcTime = unzigzag(getVarint(&next));
+
+	int64_t minimum[ARCHIVE_FIELDS];
+	int width[ARCHIVE_FIELDS];
+
+	for (int f = 0; f < ARCHIVE_FIELDS; f++) {
+		minimum[f] = unzigzag(getVarint(&next));
+		width[f] = *next++;
+	}
+
+	// Unpack a whole column at a time
+	int64_t values[ARCHIVE_FIELDS][ARCHIVE_BLOCK_EVENTS];
+
+	BitReader reader = { next, 0, 0 };
+
+	for (int f = 0; f < ARCHIVE_FIELDS; f++) {
+		for (int i = 0; i < count; i++) {
+			values[f][i] = minimum[f] + (int64_t)getBits(&reader, width[f]);
+		}
+	}
+
+	scratch->resize(count);
+
+	for (int i = 0; i < count; i++) {
+
+		eventNumber += values[ARCHIVE_EVENT_NUMBER][i];
+		wcTime += values[ARCHIVE_WC_TIME][i];
+		pcTime += values[ARCHIVE_PC_TIME][i];
+
+		(*scratch)[i] = Event(eventNumber, values[ARCHIVE_EVENT_TYPE][i],
+			values[ARCHIVE_PERIOD][i], values[ARCHIVE_ACTION_TYPE][i], wcTime,
+			pcTime, values[ARCHIVE_OPTION1][i],
+			Player(ids[archived->dictionary[values[ARCHIVE_PLAYER1][i]]]),
+			Player(ids[archived->dictionary[values[ARCHIVE_PLAYER2][i]]]),
+			Player(ids[archived->dictionary[values[ARCHIVE_PLAYER3][i]]]),
+			Team(ids[archived->dictionary[values[ARCHIVE_TEAM][i]]]));
+	}
+
+	return count;
+}
+
+ArchiveSize EventArchive::getSize() {
+
+	ArchiveSize size = ArchiveSize();
+
+	for (ArchivedGame &archived : games) {
+		size.events += archived.eventCount;
+		size.blocks += archived.data.size();
+		size.index += (archived.blockOffsets.size() +
+			archived.dictionary.size()) * sizeof(uint32_t);
+	}
+
+	for (std::string id : ids) size.idPool += id.length();
+
+	return size;
+}
+
+/* Simulate Game g of archive, pulling its Events in one block at a time */
+static void simulateArchived(EventArchive *archive, int g, Game *game,
+	std::vector<Event> *scratch, double *decodeTime) {
+
+	// Simulation starts at the clock of the first Event, once it is known
+	if (archive->getBlockCount(g) == 0) game->startSimulation();
+
+	for (int b = 0; b < archive->getBlockCount(g); b++) {
+
+		auto start = std::chrono::steady_clock::now();
+
+		int count = archive->decodeBlock(g, b, scratch);
+
+		std::chrono::duration<double> decoded =
+			std::chrono::steady_clock::now() - start;
+
+		*decodeTime += decoded.count();
+
+		for (int i = 0; i < count; i++) game->addEvent((*scratch)[i]);
+
+		if (b == 0) game->startSimulation();
+
+		// Events looking ahead into the next block wait for it
+		game->advance(b == archive->getBlockCount(g) - 1);
+	}
+
+	game->finishSimulation();
+}
+
+std::vector<Game> runArchivedGames(std::istream *gameStream,
+	std::istream *playStream, Leaderboard *leaders, int threads,
+	bool tables) {
+
+	std::vector<Game> games = makeRosters(gameStream);
+
+	auto start = std::chrono::steady_clock::now();
+
+	games = getGameEvents(games, playStream);
+
+	auto parsed = std::chrono::steady_clock::now();
+
+	EventArchive archive;
+
+	for (Game &game : games) {
+		archive.addGame(&game);
+		game.clearEvents();
+	}
+
+	threads = rangeCount(games.size(), threads);
+
+	// Worker boards share the settings of leaders, as in simulateGames
+	std::vector<Leaderboard> boards;
+
+	if (leaders != NULL) {
+		Leaderboard empty = *leaders;
+
+		empty.clear();
+
+		boards.assign(threads, empty);
+	}
+
+	// One scratch block per thread, Events only live while a Game is played
+	std::vector<std::vector<Event>> scratch(threads);
+	std::vector<double> decodeTime(threads, 0.0);
+
+	parallelRanges(games.size(), threads, [&](int thread, int begin, int end) {
+
+		for (int g = begin; g < end; g++) {
+
+			games[g].trackTables(tables);
+
+			simulateArchived(&archive, g, &games[g], &scratch[thread],
+				&decodeTime[thread]);
+
+			games[g].updateRosters();
+
+			if (!boards.empty()) boards[thread].addGame(&games[g]);
+
+			games[g].clearEvents();
+		}
+	});
+
+	for (Leaderboard &board : boards) leaders->merge(board);
+
+	ArchiveSize size = archive.getSize();
+
+	std::chrono::duration<double> parseTime = parsed - start;
+
+	double decodeSeconds = 0.0;
+
+	for (double seconds : decodeTime) decodeSeconds += seconds;
+
+	double events = std::max(size.events, (int64_t)1);
+
+	std::cout << std::fixed << std::setprecision(2) << "Archived "
+		<< size.events << " events: " << size.blocks / events
+		<< " bytes/event in blocks, " << size.index / events
+		<< " in index, " << size.idPool << " bytes of IDs" << std::endl;
+
+	std::cout << std::setprecision(1) << "Parsed at "
+		<< size.events / parseTime.count() / 1e6 << "M events/s, decoded at "
+		<< size.events / std::max(decodeSeconds, 1e-9) / 1e6
+		<< "M events/s per thread" << std::endl;
+
+	return games;
+}
@@ -0,0 +1,117 @@
+/* Event Archive Header */
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+// The Event archive keeps the Events of many Games resident in compressed
+// form. Each Game's Events are cut into blocks of ARCHIVE_BLOCK_EVENTS.
+// A block is decoded on its own, so any block can be read without the
+// blocks before it. Block layout:
+//
+//   varint     Event count
+//   zigzag     First event number, WC Time and PC Time
+//   per field  zigzag minimum, then one byte of bit width
+//   bits       For each field in turn, every Event's value minus the
+//              minimum, packed LSB first in width bits
+//
+// Event number, WC Time and PC Time are stored as deltas from the previous
+// Event of the block. Player and Team IDs are stored as codes into a
+// dictionary kept per Game. The dictionary maps each code to a handle in
+// an ID pool shared by every Game, so IDs repeated across seasons are kept
+// only once.
+
+#ifndef ARCHIVE_H_
+#define ARCHIVE_H_
+
+#include "event.hpp"
+#include "game.hpp"
+#include "leaders.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+// Archive Values
+#define ARCHIVE_BLOCK_EVENTS	128
+
+// Archive Fields
+#define ARCHIVE_EVENT_NUMBER	0	// Delta
+#define ARCHIVE_EVENT_TYPE		1
+#define ARCHIVE_PERIOD			2
+#define ARCHIVE_ACTION_TYPE		3
+#define ARCHIVE_WC_TIME			4	// Delta
+#define ARCHIVE_PC_TIME			5	// Delta
+#define ARCHIVE_OPTION1			6
+#define ARCHIVE_PLAYER1			7	// Dictionary code
+#define ARCHIVE_PLAYER2			8	// Dictionary code
+#define ARCHIVE_PLAYER3			9	// Dictionary code
+#define ARCHIVE_TEAM			10	// Dictionary code
+#define ARCHIVE_FIELDS			11
+
+/* Encoded Events of one Game */
+struct ArchivedGame {
+	std::string gameID;
+
+	int eventCount;
+
+	std::vector<uint32_t> dictionary;	// Code to ID pool handle
+	std::vector<uint32_t> blockOffsets;	// Start of each block in data
+	std::vector<uint8_t> data;
+};
+
+/* Memory held by an archive, in bytes */
+struct ArchiveSize {
+	int64_t events;
+
+	int64_t blocks;			// Encoded blocks
+	int64_t index;			// Block offsets and dictionaries
+	int64_t idPool;			// Shared ID text
+};
+
+/* Compressed, block-decodable store of Game Events */
+class EventArchive {
+
+public:
+
+	EventArchive() {}; // Default
+
+	/// Archive Functions
+
+	/// Encode every Event of Game, return its archive index
+	int addGame(Game *game);
+
+	int getGameCount();
+	int getBlockCount(int g);
+	int getEventCount(int g);
+
+	std::string getGameID(int g);
+
+	/// Decode block b of Game g into scratch, return Events decoded
+	// - Scratch keeps its capacity, so one buffer serves every block
+	int decodeBlock(int g, int b, std::vector<Event> *scratch);
+
+	ArchiveSize getSize();
+
+private:
+
+	/// Handle of ID in the shared pool, added if new
+	uint32_t idHandle(std::string id);
+
+	std::vector<ArchivedGame> games;
+
+	std::vector<std::string> ids;
+	std::unordered_map<std::string, uint32_t> idHandles;
+};
+
+/// Read every Game, archive their Events, then simulate from the archive
+// - Each thread decodes a Game's blocks into its own scratch block as it
+//   plays them, and drops the Game's Events once it is finished
+// - Leaders may be NULL. Analytics tables are filled only if tables is set.
+// - Prints archive size and parse and decode rates
+std::vector<Game> runArchivedGames(std::istream *gameStream,
+	std::istream *playStream, Leaderboard *leaders, int threads,
+	bool tables);
+
+#endif // ARCHIVE_H_
@@ -10,394 +10,747 @@
 //
 // Player plus/minus should all be accurate in v2.0
 
-#include "event.hpp"
-#include "game.hpp"
-#include "player.hpp"
-#include "team.hpp"
-
-#include <cmath>
+#include "archive.hpp"
+#include "bootstrap.hpp"
+#include "box.hpp"
+#include "cache.hpp"
+#include "checkpoint.hpp"
+#include "cube.hpp"
+#include "database.hpp"
+#include "engine.hpp"
+#include "live.hpp"
+#include "matchup.hpp"
+#include "metric.hpp"
+#include "onoff.hpp"
+#include "pace.hpp"
+#include "pair.hpp"
+#include "rapm.hpp"
+#include "season.hpp"
+#include "server.hpp"
+#include "shard.hpp"
+#include "shots.hpp"
+#include "stint.hpp"
+#include "store.hpp"
+#include "verify.hpp"
+
+#include <cstdio>
+#include <cstring>
 #include <fstream>
-#include <iomanip>
 #include <iostream>
-#include <sstream>
+#include <map>
 #include <string>
+#include <thread>
 #include <vector>
 
 
-#define BBALL_NULL	-1.0
-
-// Values in Off Rtg & Def Rtg calculation
-#define ONE_HUNDRED_POSSESSIONS	100.0
-#define ZERO					0.0
-
-// Periods in Game File
-#define PERIOD_NULL		"0"
-#define FIRST_PERIOD	"1"
-
-// Number of Players per period in Game File
-#define FULL_COURT	10
-
-// Game File Token Values
-#define GAME_GAME_ID	0
-#define GAME_PERIOD		1
-#define GAME_PLAYER_ID	2
-#define GAME_TEAM_ID	3
-#define STATUS			4
-
-// Play File Token Values
-#define PLAY_GAME_ID	0
-#define EVENT_NUMBER	1
-#define EVENT_TYPE		2
-#define PLAY_PERIOD		3
-#define WC_TIME			4
-#define PC_TIME			5
-#define ACTION_TYPE		6
-#define OPTION1			7
-#define OPTION2			8
-#define OPTION3			9
-#define PLAY_TEAM_ID	10
-#define PLAY_PERSON1	11
-#define PLAY_PERSON2	12
-#define PLAY_PERSON3	13
-#define PLAY_TEAM_TYPE	14
-#define PERSON1_TYPE	15
-#define PERSON2_TYPE	16
-#define PERSON3_TYPE	17
+// Command Line Options
+#define CAREER_STORE_OPTION		"--career-store"
+#define CAREER_LOOKUP_OPTION	"--career"
+#define CAREER_COMPACT_OPTION	"--career-compact"
+#define SERVE_OPTION			"--serve"
+#define WORKERS_OPTION			"--workers"
+#define SQLITE_OPTION			"--sqlite"
+#define GAME_FILE_OPTION		"--lineups"
+#define PLAY_FILE_OPTION		"--plays"
+#define DATA_FILE_OPTION		"--output"
+#define CACHE_OPTION			"--cache"
+#define CHECKPOINT_OPTION		"--checkpoint"
+#define RESUME_OPTION			"--resume"
+#define SEASON_OPTION			"--season"
+#define LINEUP_OPTION			"--lineup-ratings"
+#define ON_OFF_OPTION			"--on-off"
+#define PAIR_OPTION				"--pair-ratings"
+#define MATCHUP_OPTION			"--matchups"
+#define RAPM_OPTION				"--rapm"
+#define RAPM_LAMBDA_OPTION		"--rapm-lambda"
+#define STINT_OPTION			"--stints"
+#define STINT_TABLE_OPTION		"--stint-table"
+#define BOOTSTRAP_OPTION		"--bootstrap"
+#define REPLICATES_OPTION		"--bootstrap-replicates"
+#define SEED_OPTION				"--bootstrap-seed"
+#define CUBE_OPTION				"--cube"
+#define BOX_SCORE_OPTION		"--box-scores"
+#define SHOT_OPTION				"--shot-profile"
+#define PACE_OPTION				"--pace"
+#define TEAM_PACE_OPTION		"--team-pace"
+#define SEEK_OPTION				"--seek"
+#define SEEK_CLOCK_OPTION		"--seek-clock"
+#define AMEND_OPTION			"--amend"
+#define LIVE_OPTION				"--live"
+#define METRICS_OPTION			"--metrics"
+#define LEADERS_OPTION			"--leaders"
+#define LEADERS_TOP_OPTION		"--leaders-top"
+#define LEADERS_MIN_OPTION		"--leaders-min-poss"
+#define ARCHIVE_OPTION			"--archive"
+#define SHARD_DIR_OPTION		"--shard-dir"
+#define SHARDS_OPTION			"--shards"
+#define SHARD_OPTION			"--shard"
+#define MERGE_OPTION			"--merge"
+#define MANIFEST_OPTION			"--manifest"
+#define VERIFY_OPTION			"--verify"
 
 
 using namespace std;
 
 
-/* Clean double quotes from data */
-std::string cleanString(std::string str) {
+/* Get value following option in command line, empty if not given */
+std::string getOption(int argc, char **argv, std::string option) {
+
+	for (int i = 1; i + 1 < argc; i++) {
+		if (option == argv[i]) return argv[i + 1];
+	}
+
+	return "";
+}
 
-	std::string cleaned;
+/* Checks if flag option is given in command line */
+bool hasOption(int argc, char **argv, std::string option) {
 
-	for (int i = 0; i < str.length(); i++) {
-		if (str[i] != '"') cleaned.push_back(str[i]);
+	for (int i = 1; i < argc; i++) {
+		if (option == argv[i]) return true;
 	}
 
-	return cleaned;
+	return false;
 }
 
-/* Checks if File line contains header data */
-bool isValidLine(std::string line) {
+/* Get value following option, or default if not given */
+std::string getOption(int argc, char **argv, std::string option,
+	std::string defaultValue) {
+
+	std::string value = getOption(argc, argv, option);
 
-	std::size_t check = line.find("Game");
+	if (value == "") return defaultValue;
 
-	return check == std::string::npos;
+	return value;
 }
 
-/* Simulate vector of Games */
-std::vector<Game> simulateGames(std::vector<Game> gamesToPlay) {
+/* Write Player career history from store to stdout */
+void printCareer(CareerStore *store, std::string playerID) {
 
-	std::vector<Game> playedGames;
+	std::cout << "\"Game_id\",\"Person_id\",\"PointsFor\",\"PointsAgainst\","
+		<< "\"OffPoss\",\"DefPoss\"" << std::endl;
+
+	for (StoreRecord record : store->lookup(playerID)) {
+
+		std::string gameID(record.gameID,
+			strnlen(record.gameID, STORE_ID_LENGTH));
+
+		std::cout << "\"" << gameID << "\",\"" << playerID << "\","
+			<< record.pointsFor << "," << record.pointsAgainst << ","
+			<< record.offPossessions << "," << record.defPossessions
+			<< std::endl;
+	}
+}
 
-	for (Game currGame : gamesToPlay) {
+/* Run Games, only simulating those that changed since the cached run */
+std::vector<Game> runCachedGames(std::istream *gameStream,
+	std::istream *playStream, std::string cachePath) {
 
-		currGame.simulateGame();
+	ResultCache cache;
 
-		currGame.updateRosters();
+	cache.load(cachePath);
 
-		currGame.printRatings();
+	int recomputed = 0;
 
-		playedGames.push_back(currGame);
+	std::vector<GameSource> sources = splitGameSources(gameStream, playStream);
+
+	std::vector<Game> games = cache.runGames(sources, &recomputed);
+
+	if (!cache.save(cachePath)) {
+		std::cerr << "Could not write result cache " << cachePath << std::endl;
 	}
 
-	return playedGames;
-}
+	// A Game that failed alone would be missing, so run the whole input
+	if (games.size() != sources.size()) {
+		std::cerr << "Result cache is missing games, simulating all of them"
+			<< std::endl;
+
+		gameStream->clear();
+		gameStream->seekg(0);
+		playStream->clear();
+		playStream->seekg(0);
+
+		return runGames(gameStream, playStream);
+	}
 
-/* Create an Event from Play line data */
-Event makeEvent(std::string playLine) {
+	std::cout << "Simulated " << recomputed << " of " << games.size()
+		<< " games" << std::endl;
 
-	std::stringstream strStream(playLine);
+	return games;
+}
 
-	std::string playData;
+/* Run Games, committing finished ones to a checkpoint to resume from */
+// - Returns false if the run stopped because the checkpoint failed
+bool runResumableGames(std::istream *gameStream, std::istream *playStream,
+	std::string checkpointPath, bool resume, std::vector<Game> *games) {
 
-	std::vector<std::string> playTokens;
+	int resumed = 0;
+
+	if (!runCheckpointedGames(gameStream, playStream, checkpointPath, resume,
+		games, &resumed)) {
+		return false;
+	}
 
-	while (getline(strStream, playData, '\t')) {
-		playTokens.push_back(cleanString(playData));
+	if (resume) {
+		std::cout << "Resumed " << resumed << " of " << games->size()
+			<< " games" << std::endl;
 	}
 
-	int eventNumber = std::stoi(playTokens[EVENT_NUMBER]);
-	int eventType = std::stoi(playTokens[EVENT_TYPE]);
-	int period = std::stoi(playTokens[PLAY_PERIOD]);
-	int actionType = std::stoi(playTokens[ACTION_TYPE]);
-	int wcTime = std::stoi(playTokens[WC_TIME]);
-	int pcTime = std::stoi(playTokens[PC_TIME]);
-	int option = std::stoi(playTokens[OPTION1]);
-
-	std::string gameID = playTokens[PLAY_GAME_ID];
-	std::string player1ID = playTokens[PLAY_PERSON1];
-	std::string player2ID = playTokens[PLAY_PERSON2];
-	std::string player3ID = playTokens[PLAY_PERSON3];
-	std::string teamID = playTokens[PLAY_TEAM_ID];
-
-	playTokens.clear();
-
-	return Event(eventNumber, eventType, period, actionType, wcTime, pcTime,
-		option, Player(player1ID), Player(player2ID), Player(player3ID),
-		Team(teamID));
+	return true;
 }
 
-/* Make vector of Games with all Play Events */
-std::vector<Game> getGameEvents(std::vector<Game> gamesToMake,
-	std::ifstream *playStream)
-{
+/* Run one shard, merge every shard, or run each shard locally and merge */
+int runShards(int argc, char **argv, std::string shardDir) {
 
-	std::vector<Game> madeGames;
+	int shards = std::stoi(getOption(argc, argv, SHARDS_OPTION, "0"));
 
-	for (Game game : gamesToMake) {
+	if (shards < 1) {
+		std::cerr << "Sharded runs need a shard count (" << SHARDS_OPTION
+			<< " N)" << std::endl;
+		return 1;
+	}
 
-		std::string playLine;
+	std::string gamePath = getOption(argc, argv, GAME_FILE_OPTION, GAME_FILE);
+	std::string playPath = getOption(argc, argv, PLAY_FILE_OPTION, PLAY_FILE);
 
-		while (getline(*playStream, playLine)) {
+	std::ifstream gameFile(gamePath.c_str());
 
-			if (isValidLine(playLine)) {
+	std::vector<std::string> manifest = loadManifest(getOption(argc, argv,
+		MANIFEST_OPTION, shardDir + "/" + SHARD_MANIFEST), &gameFile);
 
-				// Turn Play Data line into Event
-				Event currEvent = makeEvent(playLine);
+	if (manifest.empty()) {
+		std::cerr << "No games in manifest" << std::endl;
+		return 1;
+	}
 
-				game.addEvent(currEvent);
+	// Worker of one shard, as started on each node
+	if (getOption(argc, argv, SHARD_OPTION) != "") {
 
-				if (currEvent.isGameCompleted()) {
-					game.sortEvents();
-					madeGames.push_back(game);
-					break;
-				}
-			}
+		int shard = std::stoi(getOption(argc, argv, SHARD_OPTION));
+
+		std::ifstream playFile(playPath.c_str());
+
+		if (shard < 0 || shard >= shards) {
+			std::cerr << "Shard " << shard << " is not below " << shards
+				<< std::endl;
+			return 1;
 		}
 
+		if (!gameFile.is_open() || !playFile.is_open()) {
+			std::cerr << "Could not open game and play files" << std::endl;
+			return 1;
+		}
+
+		return runShard(&gameFile, &playFile, manifest, shard, shards,
+			shardDir) ? 0 : 1;
 	}
 
-	return madeGames;
-}
+	if (!hasOption(argc, argv, MERGE_OPTION) && !runShardProcesses(gamePath,
+		playPath, manifest, shards, shardDir)) {
+		std::cerr << "A shard worker failed" << std::endl;
+		return 1;
+	}
 
-/* Bench Players not on Team court */
-Team benchPlayers(Team team) {
-	for (Player player : team.getRoster()) {
-		if (!team.isOnCourt(player)) team.addToBench(player);
+	std::ofstream dataFile(getOption(argc, argv, DATA_FILE_OPTION,
+		DATA_FILE).c_str());
+	std::ofstream seasonFile;
+
+	if (getOption(argc, argv, SEASON_OPTION) != "") {
+		seasonFile.open(getOption(argc, argv, SEASON_OPTION).c_str());
 	}
 
-	return team;
+	return mergeShards(manifest, shards, shardDir, &dataFile,
+		seasonFile.is_open() ? &seasonFile : NULL) ? 0 : 1;
 }
 
-/* Tokenize Game data from Game line */
-std::vector<std::string> getGameData(std::string gameLine) {
+/* Apply Event corrections to Games and print changed Player counters */
+void amendGames(std::vector<Game> *games, std::istream *correctionStream) {
 
-	std::stringstream strStream(gameLine);
+	std::map<std::string, std::vector<EventCorrection>> corrections =
+		readCorrections(correctionStream);
 
-	std::string gameData;
+	for (Game &game : *games) {
 
-	std::vector<std::string> gameTokens;
+		auto found = corrections.find(game.getGameID());
 
-	while (getline(strStream, gameData, '\t')) {
-		gameTokens.push_back(cleanString(gameData));
-	}
+		if (found == corrections.end()) continue;
 
-	return gameTokens;
-}
+		std::vector<CounterDelta> deltas;
 
-/* Make Game from Game ID, Teams, and vector of starters */
-Game makeGame(std::string gameID, Team homeTeam, Team awayTeam,
-	std::vector<std::vector<Player>> starters) {
+		int period = game.amendEvents(found->second, &deltas);
 
-	homeTeam = benchPlayers(homeTeam);
-	awayTeam = benchPlayers(awayTeam);
+		if (period == 0) {
+			std::cerr << "Could not amend game " << game.getGameID()
+				<< std::endl;
+			continue;
+		}
 
-	Game game = Game(gameID, homeTeam, awayTeam);
+		std::cout << "Amended game " << game.getGameID() << " from period "
+			<< period << ", " << deltas.size() << " players changed"
+			<< std::endl;
 
-	for (int i = 0; i < starters.size(); i++) {
-		game.addStarters(starters[i]);
+		for (CounterDelta delta : deltas) {
+			std::cout << "  " << delta.teamID << " " << delta.playerID << " "
+				<< delta.pointsFor << " " << delta.pointsAgainst << " "
+				<< delta.offPossessions << " " << delta.defPossessions
+				<< std::endl;
+		}
 	}
-
-	return game;
 }
 
-/* Make Player from Player ID and set if active */
-Player makePlayer(std::vector<std::string> gameTokens) {
+/* Solve adjusted plus-minus over every Game's stints and write results */
+void runRapm(std::vector<Game> *games, int workers, std::string rapmPath,
+	std::string lambdaText) {
 
-	Player player(gameTokens[GAME_PLAYER_ID]);
+	double lambda = RAPM_LAMBDA;
 
-	if (gameTokens[STATUS] == "A") player.activate();
+	if (lambdaText != "") lambda = std::stod(lambdaText);
 
-	return player;
-}
+	PlayerIndex index;
+
+	StintMatrix matrix = buildStintMatrix(games, &index);
 
-/* Return Team with new Player added to roster */
-Team addPlayerToRoster(Team team, std::vector<std::string> gameTokens) {
+	RapmResult result = solveRapm(&matrix, lambda, workers);
 
-	Player player = makePlayer(gameTokens);
+	std::cout << "RAPM: " << matrix.weight.size() << " stints, "
+		<< index.size() << " players, " << result.iterations
+		<< " iterations, home court " << result.homeCourt << std::endl;
 
-	team.addPlayer(player);
+	std::ofstream rapmFile(rapmPath.c_str());
 
-	return team;
+	writeRapmFile(result, &index, &rapmFile);
 }
 
-/* Make Team from Game ID and add first Player */
-Team makeTeam(std::vector<std::string> gameTokens) {
+/* Resample every Player's possessions and write rating intervals */
+void runBootstrap(std::vector<Game> *games, int workers,
+	std::string bootstrapPath, std::string replicateText,
+	std::string seedText) {
+
+	int replicates = BOOTSTRAP_REPLICATES;
+	uint64_t seed = BOOTSTRAP_SEED;
+
+	if (replicateText != "") replicates = std::stoi(replicateText);
+	if (seedText != "") seed = std::stoull(seedText);
 
-	Team team(gameTokens[GAME_TEAM_ID]);
+	std::vector<RatingInterval> intervals = bootstrapRatings(games,
+		replicates, seed, workers);
 
-	team = addPlayerToRoster(team, gameTokens);
+	std::ofstream bootstrapFile(bootstrapPath.c_str());
 
-	return team;
+	writeBootstrapFile(games, intervals, &bootstrapFile);
 }
 
-/* Make Game rosters for both teams */
-// - First Team listed in Game File is "Home" Team by default
-std::vector<Game> makeRosters(std::ifstream *gameStream) {
+/* Print court, bench and counters of one Team in a Game state */
+void printTeamState(Team team) {
 
-	std::vector<Game> games;
+	std::cout << team.getTeamID() << " " << team.getScore() << std::endl;
 
-	Game game;
+	for (Player player : team.getRoster()) {
+		std::cout << "  " << player.getPlayerID() << " "
+			<< (team.isOnCourt(player) ? "court" : "bench") << " "
+			<< player.getPointsFor() << " " << player.getPointsAgainst() << " "
+			<< player.getOffPossessions() << " " << player.getDefPossessions()
+			<< std::endl;
+	}
+}
 
-	Team homeTeam, awayTeam;
+/* Print Game state at clock "PERIOD:MM:SS" (game clock, counting down) */
+void printGameState(std::vector<Game> *games, std::string gameID,
+	std::string clockText) {
 
-	std::vector<std::vector<Player>> allStarters;
-	std::vector<Player> starters;
+	int period = 0, minutes = 0;
+	double seconds = 0.0;
 
-	std::string gameID = "", homeTeamID = "", awayTeamID = "", playerID = "";
+	if (std::sscanf(clockText.c_str(), "%d:%d:%lf", &period, &minutes,
+		&seconds) != 3) {
+		std::cerr << "Seek clock must be PERIOD:MM:SS" << std::endl;
+		return;
+	}
 
-	std::vector<std::string> gameTokens;
+	int pcTime = (int)((minutes * SECONDS + seconds) * TENTHS + 0.5);
 
-	std::string gameLine;
+	for (Game &game : *games) {
 
-	while (getline(*gameStream, gameLine)) {
+		if (game.getGameID() != gameID) continue;
 
-		if (isValidLine(gameLine)) {
+		GameState state;
 
-			gameTokens = getGameData(gameLine);
+		if (!game.seek(period, pcTime, &state)) break;
 
-			if (gameID == "") gameID = gameTokens[GAME_GAME_ID];
-			// Make new Game if GameIDs dont match
-			else if (gameID != gameTokens[GAME_GAME_ID]) {
+		std::cout << "Game " << gameID << " at " << clockText << std::endl;
 
-				game = makeGame(gameID, homeTeam, awayTeam, allStarters);
+		printTeamState(state.homeTeam);
+		printTeamState(state.awayTeam);
 
-				allStarters.clear();
+		return;
+	}
 
-				games.push_back(game);
-				gameID = gameTokens[GAME_GAME_ID];
-				homeTeamID = "", awayTeamID = "";
-			}
+	std::cerr << "No simulated game " << gameID << std::endl;
+}
 
-			// Add all Players to respective roster
-			if (gameTokens[GAME_PERIOD] == PERIOD_NULL) {
+/* BBall Main Function */
+int main(int argc, char **argv) {
 
-				if (homeTeamID == "") {
-					homeTeamID = gameTokens[GAME_TEAM_ID];
-					homeTeam = makeTeam(gameTokens);
-				}
-				else if (homeTeamID == gameTokens[GAME_TEAM_ID]) {
-					homeTeam = addPlayerToRoster(homeTeam, gameTokens);
-				}
-				else if (awayTeamID == "") {
-					awayTeamID = gameTokens[GAME_TEAM_ID];
-					awayTeam = makeTeam(gameTokens);
-				}
-				else if (awayTeamID == gameTokens[GAME_TEAM_ID]) {
-					awayTeam = addPlayerToRoster(awayTeam, gameTokens);
-				}
-			}
-			// Add starters to starter vector and add to court if first period
-			else {
-				if (homeTeamID == gameTokens[GAME_TEAM_ID]) {
-					if (gameTokens[GAME_PERIOD] == FIRST_PERIOD) {
-						homeTeam.addToCourt(Player(gameTokens[GAME_PLAYER_ID]));
-					}
-					starters.push_back(Player(gameTokens[GAME_PLAYER_ID]));
-				}
-				else if (awayTeamID == gameTokens[GAME_TEAM_ID]) {
-					if (gameTokens[GAME_PERIOD] == FIRST_PERIOD) {
-						awayTeam.addToCourt(Player(gameTokens[GAME_PLAYER_ID]));
-					}
-					starters.push_back(Player(gameTokens[GAME_PLAYER_ID]));
-				}
+	std::string storeDir = getOption(argc, argv, CAREER_STORE_OPTION);
+	std::string careerID = getOption(argc, argv, CAREER_LOOKUP_OPTION);
+	std::string socketPath = getOption(argc, argv, SERVE_OPTION);
+	std::string cachePath = getOption(argc, argv, CACHE_OPTION);
+	std::string checkpointPath = getOption(argc, argv, CHECKPOINT_OPTION);
+
+	bool resume = hasOption(argc, argv, RESUME_OPTION);
+
+	// Outputs built from simulation tables
+	bool needsTables = getOption(argc, argv, LINEUP_OPTION) != "" ||
+		getOption(argc, argv, ON_OFF_OPTION) != "" ||
+		getOption(argc, argv, PAIR_OPTION) != "" ||
+		getOption(argc, argv, MATCHUP_OPTION) != "" ||
+		getOption(argc, argv, RAPM_OPTION) != "" ||
+		getOption(argc, argv, STINT_OPTION) != "" ||
+		getOption(argc, argv, STINT_TABLE_OPTION) != "" ||
+		getOption(argc, argv, BOOTSTRAP_OPTION) != "" ||
+		getOption(argc, argv, CUBE_OPTION) != "" ||
+		getOption(argc, argv, BOX_SCORE_OPTION) != "" ||
+		getOption(argc, argv, SHOT_OPTION) != "" ||
+		getOption(argc, argv, PACE_OPTION) != "" ||
+		getOption(argc, argv, TEAM_PACE_OPTION) != "" ||
+		getOption(argc, argv, METRICS_OPTION) != "";
+
+	// Cached Games only restore Player counters, not simulation tables
+	bool needsSimulation = needsTables ||
+		getOption(argc, argv, SEEK_OPTION) != "" ||
+		getOption(argc, argv, AMEND_OPTION) != "";
+
+	if (cachePath != "" && needsSimulation) {
+		std::cerr << "Ignoring result cache, requested output needs every "
+			<< "game simulated" << std::endl;
+		cachePath = "";
+	}
 
-				if (starters.size() == FULL_COURT) {
-					allStarters.push_back(starters);
-					starters.clear();
-				}
-			}
-			gameTokens.clear();
-		}
+	if (resume && checkpointPath == "") {
+		std::cerr << "Resume needs a checkpoint file (" << CHECKPOINT_OPTION
+			<< " FILE)" << std::endl;
+		return 1;
 	}
 
-	// Add last Game after all Game lines read
-	game = makeGame(gameID, homeTeam, awayTeam, allStarters);
+	// Resumed Games only restore Player counters, like cached ones
+	if (resume && needsSimulation) {
+		std::cerr << "Not resuming, requested output needs every game "
+			<< "simulated" << std::endl;
+		resume = false;
+	}
 
-	games.push_back(game);
+	std::string amendPath = getOption(argc, argv, AMEND_OPTION);
+	std::string livePath = getOption(argc, argv, LIVE_OPTION);
 
-	return games;
-}
+	// Late Events rewind Team state only, replayed Events would be counted
+	// twice in simulation tables
+	if (livePath != "" && needsTables) {
+		std::cerr << "Ignoring live mode, requested output needs tables "
+			<< "of fully simulated games" << std::endl;
+		livePath = "";
+	}
 
-/* Write Player Off Rtg and Def Rtg to Data File */
-void writePlayerData(Player player, std::string gameID,
-	std::ofstream *dataStream) {
+	if (livePath != "" && (cachePath != "" || checkpointPath != "")) {
+		std::cerr << "Ignoring result cache and checkpoint in live mode"
+			<< std::endl;
+		cachePath = "";
+		checkpointPath = "";
+	}
 
-	std::string gid = "\"" + gameID + "\"";
-	std::string pid = "\"" + player.getPlayerID() + "\"";
+	// Amended Games only update Player counters, not simulation tables
+	if (amendPath != "" && needsTables) {
+		std::cerr << "Ignoring corrections, requested output needs tables "
+			<< "of fully simulated games" << std::endl;
+		amendPath = "";
+	}
 
-	int pointsFor = player.getPointsFor();
-	int pointsAgainst = player.getPointsAgainst();
+	if (cachePath != "" && checkpointPath != "") {
+		std::cerr << "Ignoring checkpoint, result cache already skips "
+			<< "finished games" << std::endl;
+		checkpointPath = "";
+	}
 
-	int offPoss = player.getOffPossessions();
-	int defPoss = player.getDefPossessions();
+	std::vector<Metric> metrics;
 
-	double oRating = BBALL_NULL;
-	double dRating = BBALL_NULL;
+	if (getOption(argc, argv, METRICS_OPTION) != "") {
+		std::ifstream metricFile(getOption(argc, argv, METRICS_OPTION).c_str());
 
-	if (offPoss == ZERO) oRating = ZERO;
-	else oRating = (pointsFor / (double)offPoss) * ONE_HUNDRED_POSSESSIONS;
+		std::string error = "cannot open file";
 
-	if (defPoss == ZERO) dRating = ZERO;
-	else dRating = (pointsAgainst / (double)defPoss) * ONE_HUNDRED_POSSESSIONS;
+		if (!metricFile.is_open() || !readMetrics(&metricFile, &metrics,
+			&error)) {
+			std::cerr << "Metrics " << getOption(argc, argv, METRICS_OPTION)
+				<< ": " << error << std::endl;
+			return 1;
+		}
+	}
 
-	*dataStream << std::fixed << std::setprecision(1) << gid << ","
-		<< pid << "," << oRating << "," << dRating << std::endl;
-}
+	int workers = std::thread::hardware_concurrency();
 
-/* Write Game Off Rtg & Def Rtg stats to Data File */
-void writeToDataFile(std::vector<Game> games, std::ofstream *dataStream) {
+	if (getOption(argc, argv, WORKERS_OPTION) != "") {
+		workers = std::stoi(getOption(argc, argv, WORKERS_OPTION));
+	}
 
-	*dataStream << "\"Game_id\",\"Person_id\",\"OffRtg\",\"DefRtg\""
-		<< std::endl;
+	// Lookup mode only reads the store
+	if (storeDir != "" && careerID != "") {
+		CareerStore store(storeDir);
 
-	for (Game game : games) {
-		for (Player player : game.getHomeTeam().getRoster()) {
-			writePlayerData(player, game.getGameID(), dataStream);
-		}
-		for (Player player : game.getAwayTeam().getRoster()) {
-			writePlayerData(player, game.getGameID(), dataStream);
+		printCareer(&store, careerID);
+
+		return 0;
+	}
+
+	// Compaction is maintenance, appends never rewrite earlier segments
+	if (storeDir != "" && hasOption(argc, argv, CAREER_COMPACT_OPTION)) {
+		CareerStore store(storeDir);
+
+		if (!store.compact()) {
+			std::cerr << "Could not compact career store " << storeDir
+				<< std::endl;
+			return 1;
 		}
+
+		return 0;
 	}
-}
 
-/* BBall Main Function */
-int main(int argc, char **argv) {
+	// Sharded runs only write the Data File and season file
+	if (getOption(argc, argv, SHARD_DIR_OPTION) != "") {
+		return runShards(argc, argv, getOption(argc, argv, SHARD_DIR_OPTION));
+	}
+
+	// Verification only checks incremental simulation, it writes no outputs
+	if (hasOption(argc, argv, VERIFY_OPTION)) {
+		std::ifstream gameFile(getOption(argc, argv, GAME_FILE_OPTION,
+			GAME_FILE).c_str());
+		std::ifstream playFile(getOption(argc, argv, PLAY_FILE_OPTION,
+			PLAY_FILE).c_str());
+
+		if (!gameFile.is_open() || !playFile.is_open()) {
+			std::cerr << "Verification needs Game File and Play File"
+				<< std::endl;
+			return 1;
+		}
+
+		int mismatches = verifyGames(&gameFile, &playFile, &std::cerr);
+
+		std::cout << "Verification found " << mismatches << " mismatches"
+			<< std::endl;
+
+		return mismatches == 0 ? 0 : 1;
+	}
 
 	std::vector<Game> games;
 
-	std::ifstream gameFile("Game_Lineup.txt");
-	std::ifstream playFile("Play_by_Play.txt");
+	Leaderboard leaders;
+
+	// Simulation only feeds a board when leaders are written
+	Leaderboard *board = NULL;
+
+	if (getOption(argc, argv, LEADERS_OPTION) != "") {
+		leaders = Leaderboard(std::stoi(getOption(argc, argv,
+			LEADERS_TOP_OPTION, std::to_string(LEADERS_TOP_K))),
+			std::stoi(getOption(argc, argv, LEADERS_MIN_OPTION,
+			std::to_string(LEADERS_MIN_POSSESSIONS))));
+		board = &leaders;
+	}
+
+	bool leadersFed = false;
 
-	std::ofstream dataFile("Kevin_M_Smith_Q1_BBALL.csv");
+	std::ifstream gameFile(getOption(argc, argv, GAME_FILE_OPTION,
+		GAME_FILE).c_str());
+	std::ifstream playFile(getOption(argc, argv, PLAY_FILE_OPTION,
+		PLAY_FILE).c_str());
+
+	std::ofstream dataFile(getOption(argc, argv, DATA_FILE_OPTION,
+		DATA_FILE).c_str());
 
 	if (gameFile.is_open()) {
-		games = makeRosters(&gameFile);
 
 		if (playFile.is_open()) {
 
-			games = getGameEvents(games, &playFile);
-			games = simulateGames(games);
+			if (livePath != "") {
+				std::ofstream liveFile(livePath.c_str());
+
+				games = runLiveGames(&gameFile, &playFile, &liveFile);
+			}
+			else if (cachePath != "") {
+				games = runCachedGames(&gameFile, &playFile, cachePath);
+			}
+			else if (checkpointPath != "") {
+				// Outputs of a run whose commits failed would not resume
+				if (!runResumableGames(&gameFile, &playFile, checkpointPath,
+					resume, &games)) {
+					return 1;
+				}
+			}
+			else if (hasOption(argc, argv, ARCHIVE_OPTION)) {
+				games = runArchivedGames(&gameFile, &playFile, board, workers,
+					needsTables);
+				leadersFed = true;
+			}
+			else {
+				games = runGames(&gameFile, &playFile, board, workers,
+					needsTables);
+				leadersFed = true;
+			}
+
+			if (amendPath != "") {
+				std::ifstream amendFile(amendPath.c_str());
 
-			if (dataFile.is_open()) {
+				amendGames(&games, &amendFile);
+
+				// Ratings of amended Games changed since they were fed
+				leaders.clear();
+				leadersFed = false;
+			}
+
+			printGames(games);
+
+			if (dataFile.is_open() && !metrics.empty()) {
+				writeMetricFile(&games, metrics, &dataFile);
+			}
+			else if (dataFile.is_open()) {
 				writeToDataFile(games, &dataFile);
 			}
 
+			if (getOption(argc, argv, LEADERS_OPTION) != "") {
+				std::ofstream leaderFile(getOption(argc, argv,
+					LEADERS_OPTION).c_str());
+
+				// Cached, resumed, live and amended Games are added here
+				if (!leadersFed) {
+					for (Game &game : games) leaders.addGame(&game);
+				}
+
+				leaders.write(&leaderFile);
+			}
+
+			if (getOption(argc, argv, SEASON_OPTION) != "") {
+				std::ofstream seasonFile(getOption(argc, argv,
+					SEASON_OPTION).c_str());
+
+				PlayerIndex index;
+
+				writeSeasonFile(aggregateSeason(&games, &index, workers),
+					&index, &seasonFile);
+			}
+
+			if (getOption(argc, argv, LINEUP_OPTION) != "") {
+				std::ofstream lineupFile(getOption(argc, argv,
+					LINEUP_OPTION).c_str());
+
+				writeLineupFile(&games, &lineupFile);
+			}
+
+			if (getOption(argc, argv, ON_OFF_OPTION) != "") {
+				std::ofstream onOffFile(getOption(argc, argv,
+					ON_OFF_OPTION).c_str());
+
+				writeOnOffFile(&games, &onOffFile);
+			}
+
+			if (getOption(argc, argv, PAIR_OPTION) != "") {
+				std::ofstream pairFile(getOption(argc, argv,
+					PAIR_OPTION).c_str());
+
+				writePairFile(&games, &pairFile);
+			}
+
+			if (getOption(argc, argv, MATCHUP_OPTION) != "") {
+				std::ofstream matchupFile(getOption(argc, argv,
+					MATCHUP_OPTION).c_str(), std::ios::binary);
+
+				if (!writeMatchupFile(&games, workers, &matchupFile)) {
+					std::cerr << "Could not write matchup file" << std::endl;
+				}
+			}
+
+			if (getOption(argc, argv, RAPM_OPTION) != "") {
+				runRapm(&games, workers, getOption(argc, argv, RAPM_OPTION),
+					getOption(argc, argv, RAPM_LAMBDA_OPTION));
+			}
+
+			if (getOption(argc, argv, STINT_OPTION) != "") {
+				std::ofstream stintFile(getOption(argc, argv,
+					STINT_OPTION).c_str());
+
+				writeStintFile(&games, &stintFile);
+			}
+
+			if (getOption(argc, argv, STINT_TABLE_OPTION) != "") {
+				std::ofstream stintTable(getOption(argc, argv,
+					STINT_TABLE_OPTION).c_str(), std::ios::binary);
+
+				writeStintTable(&games, &stintTable);
+			}
+
+			if (getOption(argc, argv, BOOTSTRAP_OPTION) != "") {
+				runBootstrap(&games, workers, getOption(argc, argv,
+					BOOTSTRAP_OPTION), getOption(argc, argv, REPLICATES_OPTION),
+					getOption(argc, argv, SEED_OPTION));
+			}
+
+			if (getOption(argc, argv, CUBE_OPTION) != "") {
+				std::ofstream cubeFile(getOption(argc, argv,
+					CUBE_OPTION).c_str());
+
+				writeCubeFile(&games, &cubeFile);
+			}
+
+			if (getOption(argc, argv, BOX_SCORE_OPTION) != "") {
+				std::ofstream boxFile(getOption(argc, argv,
+					BOX_SCORE_OPTION).c_str());
+
+				writeBoxScoreFile(&games, &boxFile);
+			}
+
+			if (getOption(argc, argv, SHOT_OPTION) != "") {
+				std::ofstream shotFile(getOption(argc, argv,
+					SHOT_OPTION).c_str());
+
+				writeShotFile(&games, &shotFile);
+			}
+
+			if (getOption(argc, argv, PACE_OPTION) != "") {
+				std::ofstream paceFile(getOption(argc, argv,
+					PACE_OPTION).c_str());
+
+				writePaceFile(&games, &paceFile);
+			}
+
+			if (getOption(argc, argv, TEAM_PACE_OPTION) != "") {
+				std::ofstream teamPaceFile(getOption(argc, argv,
+					TEAM_PACE_OPTION).c_str());
+
+				writeTeamPaceFile(&games, &teamPaceFile);
+			}
+
+			if (getOption(argc, argv, SEEK_OPTION) != "") {
+				printGameState(&games, getOption(argc, argv, SEEK_OPTION),
+					getOption(argc, argv, SEEK_CLOCK_OPTION));
+			}
+
+			if (getOption(argc, argv, SQLITE_OPTION) != "") {
+				writeToDatabase(games, getOption(argc, argv, SQLITE_OPTION));
+			}
+
+			if (storeDir != "") {
+				CareerStore store(storeDir);
+
+				if (!store.appendGames(games)) {
+					std::cerr << "Could not append to career store "
+						<< storeDir << std::endl;
+				}
+			}
+
 			std::cout << std::endl << "**Done**" << std::endl;
+
+			// Keep simulated Games resident and answer queries
+			if (socketPath != "") {
+				RatingServer server(games);
+
+				server.serve(socketPath, workers);
+			}
 		}
 	}
 }
\ No newline at end of file
@@ -0,0 +1,249 @@
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#include "bootstrap.hpp"
+#include "game.hpp"
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <iomanip>
+
+
+#define POSSESSION_POINTS_MAX	255
+
+// Possession Functions
+
+void PossessionLog::homeScore(int points) {
+	homePoints += points;
+}
+
+void PossessionLog::awayScore(int points) {
+	awayPoints += points;
+}
+
+void PossessionLog::homePossession(uint64_t homeMask, uint64_t awayMask) {
+
+	PossessionRecord record;
+
+	record.homeMask = homeMask;
+	record.awayMask = awayMask;
+	record.homeOffense = 1;
+	record.points = std::min(std::max(homePoints, 0), POSSESSION_POINTS_MAX);
+
+	possessions.push_back(record);
+
+	homePoints = 0;
+}
+
+void PossessionLog::awayPossession(uint64_t homeMask, uint64_t awayMask) {
+
+	PossessionRecord record;
+
+	record.homeMask = homeMask;
+	record.awayMask = awayMask;
+	record.homeOffense = 0;
+	record.points = std::min(std::max(awayPoints, 0), POSSESSION_POINTS_MAX);
+
+	possessions.push_back(record);
+
+	awayPoints = 0;
+}
+
+// Possession Getters
+
+const std::vector<PossessionRecord> &PossessionLog::getPossessions() {
+	return possessions;
+}
+
+// Bootstrap Functions
+
+/* SplitMix64 finalizer, a counter-based generator over (key, counter) */
+static uint64_t mixBits(uint64_t x) {
+	x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+	return x ^ (x >> 31);
+}
+
+static uint64_t streamKey(uint64_t seed, uint64_t game, uint64_t row) {
+	return mixBits(mixBits(seed + 0x9e3779b97f4a7c15ULL) ^ (game << 32 ^ row));
+}
+
+/* Value at fraction of replicates, partially sorting them */
+static double percentile(std::vector<double> *replicates, double fraction) {
+
+	int rank = (int)(fraction * (replicates->size() - 1) + 0.5);
+
+	std::nth_element(replicates->begin(), replicates->begin() + rank,
+		replicates->end());
+
+	return (*replicates)[rank];
+}
+
+/* Resample points per possession, return low and high percentiles */
+static void resample(std::vector<uint8_t> *points, uint64_t key,
+	std::vector<double> *replicates, double *low, double *high) {
+
+	uint32_t count = points->size();
+
+	if (count == 0) {
+		*low = 0.0;
+		*high = 0.0;
+		return;
+	}
+
+	const uint8_t *data = points->data();
+	uint64_t counter = 0;
+
+	for (int r = 0; r < replicates->size(); r++) {
+
+		uint32_t sum = 0;
+		uint32_t i = 0;
+
+		// Two 32 bit draws per counter, scaled into [0, count)
+		for (; i + 1 < count; i += 2) {
+
+			uint64_t bits = mixBits(key + counter++ * 0x9e3779b97f4a7c15ULL);
+
+			sum += data[((bits & 0xffffffff) * count) >> 32];
+			sum += data[((bits >> 32) * count) >> 32];
+		}
+		if (i < count) {
+
+			uint64_t bits = mixBits(key + counter++ * 0x9e3779b97f4a7c15ULL);
+
+			sum += data[((bits & 0xffffffff) * count) >> 32];
+		}
+
+		(*replicates)[r] = perHundred(sum, count);
+	}
+
+	double tail = (1.0 - BOOTSTRAP_CONFIDENCE) / 2.0;
+
+	*low = percentile(replicates, tail);
+	*high = percentile(replicates, 1.0 - tail);
+}
+
+/* Bootstrap one Team's Players, offense and defense from its side */
+static void bootstrapTeam(Team team, bool home,
+	const std::vector<PossessionRecord> *possessions, uint64_t seed,
+	uint64_t game, int firstRow, std::vector<double> *replicates,
+	std::vector<RatingInterval> *intervals) {
+
+	std::vector<Player> roster = team.getRoster();
+
+	std::vector<uint8_t> offPoints, defPoints;
+
+	for (int i = 0; i < roster.size(); i++) {
+
+		int slot = roster[i].getSlot();
+
+		offPoints.clear();
+		defPoints.clear();
+
+		if (slot >= 0 && slot < COURT_MASK_SLOTS) {
+
+			uint64_t bit = (uint64_t)1 << slot;
+
+			for (const PossessionRecord &record : *possessions) {
+
+				uint64_t mask = home ? record.homeMask : record.awayMask;
+
+				if ((mask & bit) == 0) continue;
+
+				if (record.homeOffense == home) {
+					offPoints.push_back(record.points);
+				}
+				else defPoints.push_back(record.points);
+			}
+		}
+
+		uint64_t row = firstRow + i;
+
+		RatingInterval &interval = (*intervals)[row];
+
+		resample(&offPoints, streamKey(seed, game, row * 2), replicates,
+			&interval.offLow, &interval.offHigh);
+		resample(&defPoints, streamKey(seed, game, row * 2 + 1), replicates,
+			&interval.defLow, &interval.defHigh);
+	}
+}
+
+std::vector<RatingInterval> bootstrapRatings(std::vector<Game> *games,
+	int replicates, uint64_t seed, int threads) {
+
+	if (replicates < 1) replicates = 1;
+
+	// First output row of each Game
+	std::vector<int> firstRows(games->size() + 1, 0);
+
+	for (int g = 0; g < games->size(); g++) {
+		firstRows[g + 1] = firstRows[g] +
+			(*games)[g].getHomeTeam().getTeamSize() +
+			(*games)[g].getAwayTeam().getTeamSize();
+	}
+
+	std::vector<RatingInterval> intervals(firstRows.back());
+
+	parallelRanges(games->size(), threads,
+		[&](int, int begin, int end) {
+
+		std::vector<double> buffer(replicates);
+
+		for (int g = begin; g < end; g++) {
+
+			Game &game = (*games)[g];
+
+			Team home = game.getHomeTeam();
+
+			const std::vector<PossessionRecord> &possessions =
+				game.getPossessions();
+
+			// Rows are local to the Game, so streams match for any threads
+			std::vector<RatingInterval> local(home.getTeamSize() +
+				game.getAwayTeam().getTeamSize());
+
+			bootstrapTeam(home, true, &possessions, seed, g, 0, &buffer,
+				&local);
+			bootstrapTeam(game.getAwayTeam(), false, &possessions, seed, g,
+				home.getTeamSize(), &buffer, &local);
+
+			std::copy(local.begin(), local.end(),
+				intervals.begin() + firstRows[g]);
+		}
+	});
+
+	return intervals;
+}
+
+void writeBootstrapFile(std::vector<Game> *games,
+	std::vector<RatingInterval> intervals, std::ostream *bootstrapStream) {
+
+	*bootstrapStream << "\"Game_id\",\"Person_id\",\"OffRtg\",\"DefRtg\","
+		<< "\"OffLow\",\"OffHigh\",\"DefLow\",\"DefHigh\"" << std::endl;
+
+	*bootstrapStream << std::fixed << std::setprecision(1);
+
+	int row = 0;
+
+	for (Game &game : *games) {
+
+		std::vector<Player> players = game.getHomeTeam().getRoster();
+		std::vector<Player> awayPlayers = game.getAwayTeam().getRoster();
+
+		players.insert(players.end(), awayPlayers.begin(), awayPlayers.end());
+
+		for (Player player : players) {
+
+			RatingInterval interval = intervals[row++];
+
+			*bootstrapStream << "\"" << game.getGameID() << "\",\""
+				<< player.getPlayerID() << "\","
+				<< perHundred(player.getPointsFor(), player.getOffPossessions())
+				<< ","
+				<< perHundred(player.getPointsAgainst(),
+					player.getDefPossessions())
+				<< "," << interval.offLow << "," << interval.offHigh << ","
+				<< interval.defLow << "," << interval.defHigh << std::endl;
+		}
+	}
+}
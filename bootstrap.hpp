@@ -0,0 +1,76 @@
+/* Bootstrap Intervals Header */
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#ifndef BOOTSTRAP_H_
+#define BOOTSTRAP_H_
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+
+// Bootstrap Values
+#define BOOTSTRAP_REPLICATES	2000
+#define BOOTSTRAP_CONFIDENCE	0.95
+#define BOOTSTRAP_SEED			0
+
+class Game;
+
+/* One possession with the courts on the floor when it ended */
+struct PossessionRecord {
+	uint64_t homeMask;
+	uint64_t awayMask;
+
+	uint8_t homeOffense;	// 1 if home Team had the ball
+	uint8_t points;			// Points scored by offense, capped at 255
+};
+
+/* Possessions of one Game in order, kept for resampling */
+class PossessionLog {
+
+public:
+
+	PossessionLog() { homePoints = 0; awayPoints = 0; }; // Default
+
+	/// Possession Functions
+
+	void homeScore(int points);
+	void awayScore(int points);
+
+	/// Close possession with points scored since the last one
+	void homePossession(uint64_t homeMask, uint64_t awayMask);
+	void awayPossession(uint64_t homeMask, uint64_t awayMask);
+
+	/// Possession Getters
+
+	const std::vector<PossessionRecord> &getPossessions();
+
+private:
+
+	int homePoints;	// Home points since last home possession ended
+	int awayPoints;	// Away points since last away possession ended
+
+	std::vector<PossessionRecord> possessions;
+};
+
+/* Percentile interval of OffRtg and DefRtg for one Player in one Game */
+struct RatingInterval {
+	double offLow;
+	double offHigh;
+	double defLow;
+	double defHigh;
+};
+
+/// Resample every Player's possessions in every Game with replacement
+// - Intervals are in writeToDataFile row order. Each Player side has its
+//   own counter-based random stream keyed by seed, Game and row, so the
+//   result does not depend on the thread count.
+std::vector<RatingInterval> bootstrapRatings(std::vector<Game> *games,
+	int replicates, uint64_t seed, int threads);
+
+/// Write ratings with their bootstrap intervals, one row per Player per Game
+void writeBootstrapFile(std::vector<Game> *games,
+	std::vector<RatingInterval> intervals, std::ostream *bootstrapStream);
+
+#endif // BOOTSTRAP_H_
@@ -0,0 +1,76 @@
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#include "box.hpp"
+#include "game.hpp"
+
+
+// Box Score Table Constructor
+
+BoxScoreTable::BoxScoreTable() {
+	for (int c = 0; c < BOX_COUNTERS; c++) {
+		for (int s = 0; s < COURT_MASK_SLOTS; s++) {
+			counts[c][s] = 0;
+		}
+	}
+}
+
+// Box Score Functions
+
+void BoxScoreTable::add(int slot, int counter) {
+	if (slot >= 0 && slot < COURT_MASK_SLOTS) counts[counter][slot]++;
+}
+
+// Box Score Getters
+
+int BoxScoreTable::get(int slot, int counter) const {
+
+	if (slot < 0 || slot >= COURT_MASK_SLOTS) return 0;
+
+	return counts[counter][slot];
+}
+
+// Box Score Output
+
+/* Write box score line for every roster Player of Team */
+static void writeTeamBox(std::string gameID, Team team,
+	const BoxScoreTable &table, std::ostream *boxStream) {
+
+	for (Player player : team.getRoster()) {
+
+		int slot = player.getSlot();
+
+		int fgm2 = table.get(slot, BOX_FGM2);
+		int fgm3 = table.get(slot, BOX_FGM3);
+		int ftm = table.get(slot, BOX_FTM);
+
+		int oreb = table.get(slot, BOX_OREB);
+		int dreb = table.get(slot, BOX_DREB);
+
+		*boxStream << "\"" << gameID << "\",\"" << player.getPlayerID()
+			<< "\",\"" << team.getTeamID() << "\","
+			<< (fgm2 * TWO_POINTS + fgm3 * THREE_POINTS + ftm) << ","
+			<< (fgm2 + fgm3) << ","
+			<< (table.get(slot, BOX_FGA2) + table.get(slot, BOX_FGA3)) << ","
+			<< fgm3 << "," << table.get(slot, BOX_FGA3) << "," << ftm << ","
+			<< table.get(slot, BOX_FTA) << "," << oreb << "," << dreb << ","
+			<< (oreb + dreb) << "," << table.get(slot, BOX_TOV) << ","
+			<< table.get(slot, BOX_FOULS) << ","
+			<< table.get(slot, BOX_SUBS_IN) << ","
+			<< table.get(slot, BOX_SUBS_OUT) << std::endl;
+	}
+}
+
+void writeBoxScoreFile(std::vector<Game> *games, std::ostream *boxStream) {
+
+	*boxStream << "\"Game_id\",\"Person_id\",\"Team_id\",\"PTS\",\"FGM\","
+		<< "\"FGA\",\"3PM\",\"3PA\",\"FTM\",\"FTA\",\"OREB\",\"DREB\","
+		<< "\"REB\",\"TOV\",\"PF\",\"SubIn\",\"SubOut\"" << std::endl;
+
+	for (Game &game : *games) {
+		writeTeamBox(game.getGameID(), game.getHomeTeam(), game.getHomeBox(),
+			boxStream);
+		writeTeamBox(game.getGameID(), game.getAwayTeam(), game.getAwayBox(),
+			boxStream);
+	}
+}
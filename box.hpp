@@ -0,0 +1,55 @@
+/* Box Score Header */
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#ifndef BOX_H_
+#define BOX_H_
+
+#include "team.hpp"
+
+#include <iostream>
+#include <vector>
+
+
+// Box Score Counters
+#define BOX_FGM2		0	// Two point field goals made
+#define BOX_FGA2		1	// Two point field goals attempted
+#define BOX_FGM3		2	// Three point field goals made
+#define BOX_FGA3		3	// Three point field goals attempted
+#define BOX_FTM			4
+#define BOX_FTA			5
+#define BOX_OREB		6
+#define BOX_DREB		7
+#define BOX_TOV			8
+#define BOX_FOULS		9
+#define BOX_SUBS_IN		10
+#define BOX_SUBS_OUT	11
+#define BOX_COUNTERS	12
+
+class Game;
+
+/* Box score counters for one Team of a Game */
+// - Struct of arrays, one contiguous array per counter indexed by slot
+class BoxScoreTable {
+
+public:
+
+	BoxScoreTable();
+
+	/// Box Score Functions
+
+	void add(int slot, int counter);
+
+	/// Box Score Getters
+
+	int get(int slot, int counter) const;
+
+private:
+
+	int counts[BOX_COUNTERS][COURT_MASK_SLOTS];
+};
+
+/// Write box score of every Player of every Game
+void writeBoxScoreFile(std::vector<Game> *games, std::ostream *boxStream);
+
+#endif // BOX_H_
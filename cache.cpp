@@ -0,0 +1,296 @@
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#include "cache.hpp"
+#include "engine.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+
+/* Fold text into FNV-1a hash */
+static uint64_t hashText(uint64_t hash, std::string text) {
+
+	for (int i = 0; i < text.length(); i++) {
+		hash ^= (unsigned char)text[i];
+		hash *= FNV_PRIME;
+	}
+
+	return hash;
+}
+
+/* Get the n-th tab separated token of a line, without quotes */
+static std::string lineToken(std::string line, int n) {
+
+	std::size_t start = 0;
+
+	for (int i = 0; i < n; i++) {
+		start = line.find('\t', start);
+
+		if (start == std::string::npos) return "";
+
+		start++;
+	}
+
+	std::size_t end = line.find('\t', start);
+
+	if (end == std::string::npos) end = line.length();
+
+	return cleanString(line.substr(start, end - start));
+}
+
+/* Checks if Play line is the last Event of a Game */
+static bool isGameCompleteLine(std::string playLine) {
+
+	std::string eventNumber = lineToken(playLine, EVENT_NUMBER);
+
+	return eventNumber != "" && std::stoi(eventNumber) == GAME_COMPLETE;
+}
+
+/* Get read position of stream, end of data once it is exhausted */
+static std::streamoff streamOffset(std::istream *stream) {
+
+	if (stream->eof()) {
+		stream->clear();
+		stream->seekg(0, std::ios::end);
+	}
+
+	return stream->tellg();
+}
+
+bool readGameSource(std::istream *gameStream, std::istream *playStream,
+	GameSource *source) {
+
+	source->gameID = "";
+	source->gameLines = "";
+	source->playLines = "";
+	source->hash = 0;
+
+	std::string line;
+
+	// Game File lines of a Game are contiguous
+	std::streamoff lineStart = gameStream->tellg();
+
+	while (getline(*gameStream, line)) {
+
+		if (isValidLine(line)) {
+
+			std::string gameID = lineToken(line, GAME_GAME_ID);
+
+			// First line of the next Game, leave it unread
+			if (source->gameID != "" && source->gameID != gameID) {
+				gameStream->seekg(lineStart);
+				break;
+			}
+
+			source->gameID = gameID;
+			source->gameLines += line + "\n";
+		}
+
+		lineStart = gameStream->tellg();
+	}
+
+	if (source->gameID == "") return false;
+
+	// Play File Games follow Game File order, each ends at Game complete
+	while (getline(*playStream, line)) {
+
+		if (!isValidLine(line)) continue;
+
+		source->playLines += line + "\n";
+
+		if (isGameCompleteLine(line)) break;
+	}
+
+	uint64_t hash = hashText(FNV_OFFSET, ENGINE_VERSION);
+
+	hash = hashText(hash, source->gameLines);
+	hash = hashText(hash, std::string(1, '\0'));
+	hash = hashText(hash, source->playLines);
+
+	source->hash = hash;
+
+	source->gameOffset = streamOffset(gameStream);
+	source->playOffset = streamOffset(playStream);
+
+	return true;
+}
+
+std::vector<GameSource> splitGameSources(std::istream *gameStream,
+	std::istream *playStream) {
+
+	std::vector<GameSource> sources;
+
+	GameSource source;
+
+	while (readGameSource(gameStream, playStream, &source)) {
+		sources.push_back(source);
+	}
+
+	return sources;
+}
+
+// Cache Functions
+
+void saveTeam(Team team, std::ostream *cacheStream) {
+
+	std::vector<Player> roster = team.getRoster();
+
+	*cacheStream << "T " << team.getTeamID() << " " << team.getScore() << " "
+		<< team.getOffPossessions() << " " << team.getDefPossessions() << " "
+		<< roster.size() << "\n";
+
+	for (Player player : roster) {
+		*cacheStream << "P " << player.getPlayerID() << " "
+			<< player.isActive() << " " << player.getPointsFor() << " "
+			<< player.getPointsAgainst() << " " << player.getOffPossessions()
+			<< " " << player.getDefPossessions() << "\n";
+	}
+}
+
+bool loadTeam(std::istream *cacheStream, Team *team) {
+
+	std::string tag, teamID;
+	int score, offPoss, defPoss, rosterSize;
+
+	if (!(*cacheStream >> tag >> teamID >> score >> offPoss >> defPoss
+		>> rosterSize) || tag != "T") {
+		return false;
+	}
+
+	*team = Team(teamID);
+	team->setCounters(score, offPoss, defPoss);
+
+	for (int i = 0; i < rosterSize; i++) {
+
+		std::string playerID;
+		int active, pointsFor, pointsAgainst;
+
+		if (!(*cacheStream >> tag >> playerID >> active >> pointsFor
+			>> pointsAgainst >> offPoss >> defPoss) || tag != "P") {
+			return false;
+		}
+
+		Player player(playerID);
+
+		if (active) player.activate();
+
+		player.setCounters(pointsFor, pointsAgainst, offPoss, defPoss);
+
+		team->addPlayer(player);
+	}
+
+	return true;
+}
+
+bool ResultCache::load(std::string path) {
+
+	games.clear();
+
+	std::ifstream cacheFile(path.c_str());
+
+	std::string header, version;
+
+	if (!(cacheFile >> header >> version) || header != CACHE_HEADER ||
+		version != ENGINE_VERSION) {
+		return false;
+	}
+
+	std::string tag, gameID;
+	uint64_t hash;
+
+	while (cacheFile >> tag >> gameID >> std::hex >> hash >> std::dec) {
+
+		Team home, away;
+
+		if (tag != "G" || !loadTeam(&cacheFile, &home) ||
+			!loadTeam(&cacheFile, &away)) {
+
+			games.clear();
+			return false;
+		}
+
+		CachedGame cached;
+
+		cached.hash = hash;
+		cached.game = Game(gameID, home, away);
+
+		games[gameID] = cached;
+	}
+
+	return true;
+}
+
+bool ResultCache::save(std::string path) {
+
+	std::string tmpPath = path + ".tmp";
+
+	std::ofstream cacheFile(tmpPath.c_str());
+
+	if (!cacheFile.is_open()) return false;
+
+	cacheFile << CACHE_HEADER << " " << ENGINE_VERSION << "\n";
+
+	for (auto &entry : games) {
+
+		cacheFile << "G " << entry.first << " " << std::hex
+			<< entry.second.hash << std::dec << "\n";
+
+		saveTeam(entry.second.game.getHomeTeam(), &cacheFile);
+		saveTeam(entry.second.game.getAwayTeam(), &cacheFile);
+	}
+
+	cacheFile.close();
+
+	if (cacheFile.fail() || std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+		std::remove(tmpPath.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+std::vector<Game> ResultCache::runGames(std::vector<GameSource> sources,
+	int *recomputed) {
+
+	std::vector<Game> results;
+	std::map<std::string, CachedGame> current;
+
+	*recomputed = 0;
+
+	for (GameSource source : sources) {
+
+		auto found = games.find(source.gameID);
+
+		CachedGame cached;
+
+		if (found != games.end() && found->second.hash == source.hash) {
+			cached = found->second;
+		}
+		else {
+			std::istringstream gameStream(source.gameLines);
+			std::istringstream playStream(source.playLines);
+
+			std::vector<Game> played = ::runGames(&gameStream, &playStream);
+
+			if (played.empty()) {
+				std::cerr << "Could not simulate game " << source.gameID
+					<< " from its own lines" << std::endl;
+				continue;
+			}
+
+			cached.hash = source.hash;
+			cached.game = played[0];
+
+			(*recomputed)++;
+		}
+
+		current[source.gameID] = cached;
+		results.push_back(cached.game);
+	}
+
+	games = current;
+
+	return results;
+}
@@ -0,0 +1,85 @@
+/* Result Cache Header */
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#ifndef CACHE_H_
+#define CACHE_H_
+
+#include "game.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+
+// Cache File Values
+#define CACHE_HEADER	"BBALL_CACHE"
+
+// FNV-1a Hash Values
+#define FNV_OFFSET	14695981039346656037ULL
+#define FNV_PRIME	1099511628211ULL
+
+/* Raw Game File and Play File lines of one Game */
+struct GameSource {
+	std::string gameID;
+
+	std::string gameLines;
+	std::string playLines;
+
+	uint64_t hash;	// Hash of engine version and both sets of lines
+
+	std::streamoff gameOffset;	// Stream offsets just past this Game
+	std::streamoff playOffset;
+};
+
+/* Simulated results of one Game, keyed by its source hash */
+struct CachedGame {
+	uint64_t hash;
+	Game game;
+};
+
+/// Read the next Game's lines from seekable Game and Play streams
+// - Returns false once the Game stream has no more Games
+bool readGameSource(std::istream *gameStream, std::istream *playStream,
+	GameSource *source);
+
+/// Split Game and Play streams into per-Game sources and hash each one
+std::vector<GameSource> splitGameSources(std::istream *gameStream,
+	std::istream *playStream);
+
+/// Write Team counters and roster in cache file layout
+void saveTeam(Team team, std::ostream *cacheStream);
+
+/// Read Team saved by saveTeam, return false if malformed
+bool loadTeam(std::istream *cacheStream, Team *team);
+
+/* Persistent cache of simulated Games */
+// - Games are only parsed and simulated when their lines change
+class ResultCache {
+
+public:
+
+	ResultCache() {}; // Default
+
+	/// Cache Functions
+
+	/// Read cache file, return false if missing or from another engine
+	bool load(std::string path);
+
+	/// Write cache file, replacing any earlier one
+	bool save(std::string path);
+
+	/// Return simulated Games for sources, recomputing uncached ones
+	// - Cache afterwards holds exactly the Games of sources that simulated
+	// - A source that does not simulate on its own is reported and left out
+	std::vector<Game> runGames(std::vector<GameSource> sources,
+		int *recomputed);
+
+private:
+
+	std::map<std::string, CachedGame> games;	// Cached Games by Game ID
+};
+
+#endif // CACHE_H_
@@ -0,0 +1,285 @@
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#include "checkpoint.hpp"
+#include "cache.hpp"
+#include "engine.hpp"
+
+#include <cerrno>
+#include <fstream>
+#include <sstream>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+
+/* Write all of data to descriptor, retrying short and interrupted writes */
+static bool writeAll(int fd, std::string data) {
+
+	const char *next = data.data();
+	size_t left = data.size();
+
+	while (left > 0) {
+
+		ssize_t written = write(fd, next, left);
+
+		if (written < 0 && errno == EINTR) continue;
+		if (written <= 0) return false;
+
+		next += written;
+		left -= written;
+	}
+
+	return true;
+}
+
+// RunCheckpoint Constructor
+
+RunCheckpoint::RunCheckpoint(std::string p) {
+	path = p;
+
+	gameOffset = 0;
+	playOffset = 0;
+
+	committed = 0;
+
+	journal = -1;
+}
+
+RunCheckpoint::~RunCheckpoint() {
+	closeJournal();
+}
+
+// Checkpoint Functions
+
+void RunCheckpoint::closeJournal() {
+
+	if (journal >= 0) close(journal);
+
+	journal = -1;
+}
+
+bool RunCheckpoint::resume(std::vector<Game> *games) {
+
+	std::ifstream checkpointFile(path.c_str());
+
+	std::string header, version;
+
+	if (!(checkpointFile >> header >> version) || header != CHECKPOINT_HEADER ||
+		version != ENGINE_VERSION) {
+		return false;
+	}
+
+	std::streamoff commitEnd = checkpointFile.tellg();
+
+	std::vector<Game> pending;
+	std::string tag;
+
+	// Stop at the first record that is incomplete
+	while (checkpointFile >> tag) {
+
+		if (tag == "G") {
+
+			std::string gameID;
+			Team home, away;
+
+			if (!(checkpointFile >> gameID) || !loadTeam(&checkpointFile, &home)
+				|| !loadTeam(&checkpointFile, &away)) {
+				break;
+			}
+
+			pending.push_back(Game(gameID, home, away));
+		}
+		else if (tag == "C") {
+
+			std::streamoff gameOff, playOff;
+			int count;
+
+			// A torn count never matches the Games read
+			if (!(checkpointFile >> gameOff >> playOff >> count) ||
+				count != committed + (int)pending.size()) {
+				break;
+			}
+
+			games->insert(games->end(), pending.begin(), pending.end());
+			pending.clear();
+
+			gameOffset = gameOff;
+			playOffset = playOff;
+			committed = count;
+
+			commitEnd = checkpointFile.tellg();
+		}
+		else break;
+	}
+
+	checkpointFile.close();
+
+	// Cut off the uncommitted tail, then keep appending on a new line
+	if (truncate(path.c_str(), commitEnd) != 0) return false;
+
+	closeJournal();
+
+	journal = open(path.c_str(), O_WRONLY | O_APPEND);
+
+	return journal >= 0 && writeAll(journal, "\n");
+}
+
+bool RunCheckpoint::start() {
+
+	gameOffset = 0;
+	playOffset = 0;
+
+	committed = 0;
+
+	closeJournal();
+
+	journal = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+	if (journal < 0) return false;
+
+	std::string header = std::string(CHECKPOINT_HEADER) + " " +
+		ENGINE_VERSION + "\n";
+
+	return writeAll(journal, header);
+}
+
+bool RunCheckpoint::commit(std::vector<Game> *games,
+	std::streamoff gameOff, std::streamoff playOff) {
+
+	if (journal < 0) return false;
+
+	std::ostringstream block;
+
+	for (Game &game : *games) {
+
+		block << "G " << game.getGameID() << "\n";
+
+		saveTeam(game.getHomeTeam(), &block);
+		saveTeam(game.getAwayTeam(), &block);
+	}
+
+	int count = committed + games->size();
+
+	// Commit line goes out last, after every Game of the block
+	block << "C " << gameOff << " " << playOff << " " << count << "\n";
+
+	// Synced, so the commit also survives a power loss or kernel crash
+	if (!writeAll(journal, block.str()) || fsync(journal) != 0) return false;
+
+	committed = count;
+
+	gameOffset = gameOff;
+	playOffset = playOff;
+
+	return true;
+}
+
+// Checkpoint Variable Getters
+
+std::streamoff RunCheckpoint::getGameOffset() {
+	return gameOffset;
+}
+
+std::streamoff RunCheckpoint::getPlayOffset() {
+	return playOffset;
+}
+
+/* Get length of seekable stream, leaving it at the start */
+static std::streamoff streamLength(std::istream *stream) {
+
+	stream->seekg(0, std::ios::end);
+
+	std::streamoff length = stream->tellg();
+
+	stream->seekg(0, std::ios::beg);
+
+	return length;
+}
+
+/* Commit finished Games and move them to games, report if it fails */
+static bool commitFinished(RunCheckpoint *checkpoint,
+	std::vector<Game> *finished, std::streamoff gameOffset,
+	std::streamoff playOffset, std::vector<Game> *games) {
+
+	if (!checkpoint->commit(finished, gameOffset, playOffset)) {
+		std::cerr << "Could not commit checkpoint, stopping the run"
+			<< std::endl;
+		return false;
+	}
+
+	games->insert(games->end(), finished->begin(), finished->end());
+	finished->clear();
+
+	return true;
+}
+
+bool runCheckpointedGames(std::istream *gameStream, std::istream *playStream,
+	std::string checkpointPath, bool resume, std::vector<Game> *games,
+	int *resumed) {
+
+	RunCheckpoint checkpoint(checkpointPath);
+
+	*resumed = 0;
+
+	if (resume && checkpoint.resume(games)) {
+
+		// Offsets past the end mean the input files were replaced
+		if (checkpoint.getGameOffset() > streamLength(gameStream) ||
+			checkpoint.getPlayOffset() > streamLength(playStream)) {
+
+			std::cerr << "Checkpoint " << checkpointPath << " does not match "
+				<< "the input files, starting over" << std::endl;
+
+			games->clear();
+			resume = false;
+		}
+		else {
+			gameStream->seekg(checkpoint.getGameOffset());
+			playStream->seekg(checkpoint.getPlayOffset());
+
+			*resumed = games->size();
+		}
+	}
+	else {
+		games->clear();
+		resume = false;
+	}
+
+	if (!resume && !checkpoint.start()) {
+		std::cerr << "Could not write checkpoint " << checkpointPath
+			<< std::endl;
+		return false;
+	}
+
+	std::vector<Game> finished;
+
+	std::streamoff gameOffset = checkpoint.getGameOffset();
+	std::streamoff playOffset = checkpoint.getPlayOffset();
+
+	GameSource source;
+
+	while (readGameSource(gameStream, playStream, &source)) {
+
+		std::istringstream gameLines(source.gameLines);
+		std::istringstream playLines(source.playLines);
+
+		std::vector<Game> played = runGames(&gameLines, &playLines);
+
+		finished.insert(finished.end(), played.begin(), played.end());
+
+		gameOffset = source.gameOffset;
+		playOffset = source.playOffset;
+
+		if (finished.size() < CHECKPOINT_INTERVAL) continue;
+
+		// Running on would finish Games a resume could not find
+		if (!commitFinished(&checkpoint, &finished, gameOffset, playOffset,
+			games)) {
+			return false;
+		}
+	}
+
+	return finished.empty() || commitFinished(&checkpoint, &finished,
+		gameOffset, playOffset, games);
+}
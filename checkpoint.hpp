@@ -0,0 +1,89 @@
+/* Run Checkpoint Header */
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+// A checkpoint file is a journal of completed Games. Each block holds the
+// results of CHECKPOINT_INTERVAL Games (cache file layout, see cache.hpp)
+// followed by a commit line with the Game File and Play File byte offsets
+// just past its last Game:
+//
+//   BBALL_CHECKPOINT <engine version>
+//   G <game id>
+//   T ... / P ...        (home, then away Team)
+//   C <game offset> <play offset> <games committed>
+//
+// A block only counts once its commit line is written and synced to disk,
+// so a run killed mid-write, or a machine that goes down, resumes from the
+// previous commit and the torn tail is cut off.
+
+#ifndef CHECKPOINT_H_
+#define CHECKPOINT_H_
+
+#include "game.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+// Checkpoint File Values
+#define CHECKPOINT_HEADER	"BBALL_CHECKPOINT"
+#define CHECKPOINT_INTERVAL	50	// Games per commit
+
+/* Append-only journal of completed Games and input stream offsets */
+class RunCheckpoint {
+
+public:
+
+	RunCheckpoint(std::string path);
+	~RunCheckpoint();
+
+	/// Checkpoint Functions
+
+	/// Read committed Games and offsets, cutting off any uncommitted tail
+	// - Returns false if missing or from another engine
+	bool resume(std::vector<Game> *games);
+
+	/// Start a new checkpoint file, discarding any earlier one
+	bool start();
+
+	/// Append finished Games and commit them with the stream offsets
+	// - Returns false, leaving the offsets of the last commit, unless the
+	//   block is written and synced through the journal descriptor
+	bool commit(std::vector<Game> *games, std::streamoff gameOffset,
+		std::streamoff playOffset);
+
+	/// Checkpoint Variable Getters
+
+	std::streamoff getGameOffset();
+	std::streamoff getPlayOffset();
+
+private:
+
+	RunCheckpoint(const RunCheckpoint &);
+	RunCheckpoint &operator=(const RunCheckpoint &);
+
+	/// Close the journal descriptor, if open
+	void closeJournal();
+
+	std::string path;
+
+	int journal;	// Descriptor appended to, -1 if not open
+
+	std::streamoff gameOffset;	// Input offsets of the last commit
+	std::streamoff playOffset;
+
+	int committed;	// Games in the journal
+};
+
+/// Run Games from seekable streams into games, committing to checkpoint as
+/// they finish
+// - With resume, committed Games are restored and the streams continue from
+//   the recorded offsets. Restored Games only carry Player counters.
+// - Returns false, stopping the run, if the checkpoint cannot be started or
+//   a commit cannot be written and synced
+bool runCheckpointedGames(std::istream *gameStream, std::istream *playStream,
+	std::string checkpointPath, bool resume, std::vector<Game> *games,
+	int *resumed);
+
+#endif // CHECKPOINT_H_
@@ -0,0 +1,48 @@
+/* Event Codes Header */
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#ifndef CODES_H_
+#define CODES_H_
+
+
+// Shot Families of Made and Missed Shot action types
+#define SHOT_NONE		0
+#define SHOT_JUMP		1
+#define SHOT_LAYUP		2
+#define SHOT_DUNK		3
+#define SHOT_HOOK		4
+#define SHOT_TIP		5
+#define SHOT_FAMILIES	6
+
+/* Descriptor of one (Event type, action type) from Event_Codes.txt */
+struct EventCode {
+	int eventType;
+	int actionType;
+
+	const char *eventName;
+	const char *actionName;
+
+	int shotFamily;			// SHOT_NONE unless a Made or Missed Shot
+	bool finalFreeThrow;	// Free Throw "N of N"
+};
+
+// Generated at build time from Event_Codes.txt
+#include "event_codes.hpp"
+
+/// Descriptor of Event type and action type, NULL if not in Event_Codes.txt
+constexpr const EventCode *findEventCode(int eventType, int actionType) {
+	return (eventType < 0 || eventType >= EVENT_CODE_TYPES ||
+		actionType < 0 || actionType >= EVENT_CODE_ACTIONS ||
+		EVENT_CODE_INDEX[eventType][actionType] < 0) ? nullptr :
+		&EVENT_CODES[EVENT_CODE_INDEX[eventType][actionType]];
+}
+
+/// Whether Event type and action type are in Event_Codes.txt
+constexpr bool hasEventCode(int eventType, int actionType) {
+	return eventType >= 0 && eventType < EVENT_CODE_TYPES &&
+		actionType >= 0 && actionType < EVENT_CODE_ACTIONS &&
+		EVENT_CODE_INDEX[eventType][actionType] >= 0;
+}
+
+#endif // CODES_H_
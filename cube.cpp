@@ -0,0 +1,163 @@
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#include "cube.hpp"
+#include "game.hpp"
+#include "season.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <string>
+
+
+static const char *MARGIN_LABELS[CUBE_MARGINS] = {
+	"<=-10", "-9..-4", "-3..3", "4..9", ">=10"
+};
+
+static const char *SIDE_LABELS[CUBE_SIDES] = { "Home", "Away" };
+
+int cubeCell(int period, int margin, int pcTime) {
+
+	int periodIndex = std::min(std::max(period, 1), CUBE_PERIODS) - 1;
+
+	int marginIndex = 2;
+
+	if (margin <= -CUBE_WIDE_MARGIN) marginIndex = 0;
+	else if (margin < -CUBE_CLOSE_MARGIN) marginIndex = 1;
+	else if (margin >= CUBE_WIDE_MARGIN) marginIndex = 4;
+	else if (margin > CUBE_CLOSE_MARGIN) marginIndex = 3;
+
+	int clutch = period >= CLUTCH_PERIOD && pcTime <= CLUTCH_TIME;
+
+	return (periodIndex * CUBE_MARGINS + marginIndex) * CUBE_CLUTCH + clutch;
+}
+
+// Cube Table Constructor
+
+CubeTable::CubeTable(int slotCount) {
+
+	if (slotCount > COURT_MASK_SLOTS) slotCount = COURT_MASK_SLOTS;
+
+	slots = slotCount;
+
+	CubeTotals empty = { 0, 0, 0, 0 };
+
+	cells.assign(slots * CUBE_CELLS, empty);
+}
+
+// Cube Functions
+
+void CubeTable::addCell(uint64_t mask, int cell, int CubeTotals::*field,
+	int amount) {
+
+	if (slots < COURT_MASK_SLOTS) mask &= ((uint64_t)1 << slots) - 1;
+
+	for (; mask != 0; mask &= mask - 1) {
+		cells[lowestCourtSlot(mask) * CUBE_CELLS + cell].*field += amount;
+	}
+}
+
+void CubeTable::offPossession(uint64_t mask, int cell) {
+	addCell(mask, cell, &CubeTotals::offPossessions, 1);
+}
+
+void CubeTable::defPossession(uint64_t mask, int cell) {
+	addCell(mask, cell, &CubeTotals::defPossessions, 1);
+}
+
+void CubeTable::score(uint64_t mask, int cell, int points) {
+	addCell(mask, cell, &CubeTotals::pointsFor, points);
+}
+
+void CubeTable::scoredOn(uint64_t mask, int cell, int points) {
+	addCell(mask, cell, &CubeTotals::pointsAgainst, points);
+}
+
+// Cube Getters
+
+int CubeTable::getSlotCount() const {
+	return slots;
+}
+
+CubeTotals CubeTable::getCell(int slot, int cell) const {
+	return cells[slot * CUBE_CELLS + cell];
+}
+
+// Season Cube Output
+
+/* Add one Team's cube from a Game to the season cube of side */
+static void addTeamCube(std::vector<CubeTotals> *season, PlayerIndex *index,
+	Team team, const CubeTable &table, int side) {
+
+	CubeTotals empty = { 0, 0, 0, 0 };
+
+	for (Player player : team.getRoster()) {
+
+		int slot = player.getSlot();
+
+		if (slot < 0 || slot >= table.getSlotCount()) continue;
+
+		int handle = index->intern(player.getPlayerID());
+
+		season->resize(index->size() * CUBE_SIDES * CUBE_CELLS, empty);
+
+		CubeTotals *row = &(*season)[(handle * CUBE_SIDES + side) *
+			CUBE_CELLS];
+
+		for (int c = 0; c < CUBE_CELLS; c++) {
+
+			CubeTotals cell = table.getCell(slot, c);
+
+			row[c].offPossessions += cell.offPossessions;
+			row[c].defPossessions += cell.defPossessions;
+			row[c].pointsFor += cell.pointsFor;
+			row[c].pointsAgainst += cell.pointsAgainst;
+		}
+	}
+}
+
+void writeCubeFile(std::vector<Game> *games, std::ostream *cubeStream) {
+
+	PlayerIndex index;
+
+	std::vector<CubeTotals> season;
+
+	for (Game &game : *games) {
+		addTeamCube(&season, &index, game.getHomeTeam(), game.getHomeCube(),
+			0);
+		addTeamCube(&season, &index, game.getAwayTeam(), game.getAwayCube(),
+			1);
+	}
+
+	*cubeStream << "\"Person_id\",\"Period\",\"Margin\",\"Clutch\",\"Side\","
+		<< "\"OffPoss\",\"DefPoss\",\"PointsFor\",\"PointsAgainst\","
+		<< "\"OffRtg\",\"DefRtg\"" << std::endl;
+
+	for (int h = 0; h < index.size(); h++) {
+		for (int side = 0; side < CUBE_SIDES; side++) {
+			for (int c = 0; c < CUBE_CELLS; c++) {
+
+				CubeTotals cell = season[(h * CUBE_SIDES + side) * CUBE_CELLS +
+					c];
+
+				if (cell.offPossessions == 0 && cell.defPossessions == 0) {
+					continue;
+				}
+
+				int clutch = c % CUBE_CLUTCH;
+				int margin = c / CUBE_CLUTCH % CUBE_MARGINS;
+				int period = c / (CUBE_CLUTCH * CUBE_MARGINS) + 1;
+
+				*cubeStream << std::fixed << std::setprecision(1) << "\""
+					<< index.getPlayerID(h) << "\"," << period << ",\""
+					<< MARGIN_LABELS[margin] << "\"," << clutch << ",\""
+					<< SIDE_LABELS[side] << "\"," << cell.offPossessions << ","
+					<< cell.defPossessions << "," << cell.pointsFor << ","
+					<< cell.pointsAgainst << ","
+					<< perHundred(cell.pointsFor, cell.offPossessions) << ","
+					<< perHundred(cell.pointsAgainst, cell.defPossessions)
+					<< std::endl;
+			}
+		}
+	}
+}
@@ -0,0 +1,78 @@
+/* Ratings Cube Header */
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#ifndef CUBE_H_
+#define CUBE_H_
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+
+// Cube Dimensions
+#define CUBE_PERIODS	5		// Four quarters, then every overtime
+#define CUBE_MARGINS	5		// Score margin buckets, see cubeCell
+#define CUBE_CLUTCH		2		// Outside or inside clutch window
+#define CUBE_SIDES		2		// Home or away
+#define CUBE_CELLS		(CUBE_PERIODS * CUBE_MARGINS * CUBE_CLUTCH)
+
+// Cube Buckets
+#define CUBE_CLOSE_MARGIN	3		// |margin| <= 3 is a close game
+#define CUBE_WIDE_MARGIN	10		// |margin| >= 10 is a blowout
+#define CLUTCH_PERIOD		4		// First period with a clutch window
+#define CLUTCH_TIME			3000	// PC Time (tenth sec) window starts
+
+class Game;
+
+/// Cell of a Team's possession from period, its score margin and PC Time
+// - Margin buckets: <= -10, -9 to -4, -3 to 3, 4 to 9, >= 10
+int cubeCell(int period, int margin, int pcTime);
+
+/* Possessions and points for one roster slot in one cube cell */
+struct CubeTotals {
+	int offPossessions;
+	int defPossessions;
+	int pointsFor;
+	int pointsAgainst;
+};
+
+/* Dense slot by cell totals for one Team of a Game */
+class CubeTable {
+
+public:
+
+	CubeTable() { slots = 0; }; // Default
+
+	/// Construct empty cube for roster of slot count Players
+	CubeTable(int slotCount);
+
+	/// Cube Functions
+
+	/// Add to cell of every slot in court mask (from Team::getCourtMask)
+	void offPossession(uint64_t mask, int cell);
+	void defPossession(uint64_t mask, int cell);
+
+	void score(uint64_t mask, int cell, int points);
+	void scoredOn(uint64_t mask, int cell, int points);
+
+	/// Cube Getters
+
+	int getSlotCount() const;
+
+	CubeTotals getCell(int slot, int cell) const;
+
+private:
+
+	/// Add to one field of cell for every slot in mask
+	void addCell(uint64_t mask, int cell, int CubeTotals::*field,
+		int amount);
+
+	int slots;						// Roster slots in cube
+	std::vector<CubeTotals> cells;	// Slot s, cell c at s * CUBE_CELLS + c
+};
+
+/// Write season ratings of every Player in every non-empty cube cell
+void writeCubeFile(std::vector<Game> *games, std::ostream *cubeStream);
+
+#endif // CUBE_H_
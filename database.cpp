@@ -0,0 +1,214 @@
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#include "database.hpp"
+
+#include <cstdio>
+#include <iostream>
+
+#ifdef BBALL_SQLITE
+
+#include <sqlite3.h>
+
+
+static const char *DATABASE_SCHEMA =
+	"DROP TABLE IF EXISTS ratings;"
+	"DROP TABLE IF EXISTS players;"
+	"DROP TABLE IF EXISTS games;"
+	"CREATE TABLE games (game_id TEXT PRIMARY KEY, home_team_id TEXT,"
+	" away_team_id TEXT, home_score INTEGER, away_score INTEGER);"
+	"CREATE TABLE players (player_id TEXT PRIMARY KEY);"
+	"CREATE TABLE ratings (game_id TEXT, player_id TEXT, team_id TEXT,"
+	" points_for INTEGER, points_against INTEGER, off_poss INTEGER,"
+	" def_poss INTEGER, off_rtg REAL, def_rtg REAL);";
+
+// Indexes are built once every row is loaded
+static const char *DATABASE_INDEXES =
+	"CREATE INDEX ratings_game ON ratings (game_id);"
+	"CREATE INDEX ratings_player ON ratings (player_id);";
+
+static const char *INSERT_GAME =
+	"INSERT OR REPLACE INTO games VALUES (?, ?, ?, ?, ?)";
+static const char *INSERT_PLAYER =
+	"INSERT OR IGNORE INTO players VALUES (?)";
+static const char *INSERT_RATING =
+	"INSERT INTO ratings VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)";
+
+/* Run SQL without results, print error if it fails */
+static bool execute(sqlite3 *db, const char *sql) {
+
+	char *error = NULL;
+
+	if (sqlite3_exec(db, sql, NULL, NULL, &error) != SQLITE_OK) {
+		std::cerr << "SQLite error: " << error << std::endl;
+		sqlite3_free(error);
+		return false;
+	}
+
+	return true;
+}
+
+static void bindText(sqlite3_stmt *stmt, int column, std::string text) {
+	sqlite3_bind_text(stmt, column, text.data(), text.length(),
+		SQLITE_TRANSIENT);
+}
+
+/* Step a bound statement and reset it for the next row */
+static bool insertRow(sqlite3 *db, sqlite3_stmt *stmt) {
+
+	bool inserted = sqlite3_step(stmt) == SQLITE_DONE;
+
+	if (!inserted) {
+		std::cerr << "SQLite error: " << sqlite3_errmsg(db) << std::endl;
+	}
+
+	sqlite3_reset(stmt);
+
+	return inserted;
+}
+
+/* Prepared statements reused for every row */
+struct DatabaseInserts {
+	sqlite3 *db;
+
+	sqlite3_stmt *game;
+	sqlite3_stmt *player;
+	sqlite3_stmt *rating;
+
+	int rows;	// Rows in current transaction
+};
+
+/* Commit current transaction once it reaches the batch size */
+static bool countRow(DatabaseInserts *inserts) {
+
+	if (++inserts->rows < DATABASE_BATCH_SIZE) return true;
+
+	inserts->rows = 0;
+
+	return execute(inserts->db, "COMMIT; BEGIN");
+}
+
+static bool insertTeam(DatabaseInserts *inserts, std::string gameID,
+	Team team) {
+
+	std::string teamID = team.getTeamID();
+
+	for (Player player : team.getRoster()) {
+
+		bindText(inserts->player, 1, player.getPlayerID());
+
+		if (!insertRow(inserts->db, inserts->player)) return false;
+
+		bindText(inserts->rating, 1, gameID);
+		bindText(inserts->rating, 2, player.getPlayerID());
+		bindText(inserts->rating, 3, teamID);
+		sqlite3_bind_int(inserts->rating, 4, player.getPointsFor());
+		sqlite3_bind_int(inserts->rating, 5, player.getPointsAgainst());
+		sqlite3_bind_int(inserts->rating, 6, player.getOffPossessions());
+		sqlite3_bind_int(inserts->rating, 7, player.getDefPossessions());
+		sqlite3_bind_double(inserts->rating, 8,
+			perHundred(player.getPointsFor(), player.getOffPossessions()));
+		sqlite3_bind_double(inserts->rating, 9,
+			perHundred(player.getPointsAgainst(), player.getDefPossessions()));
+
+		if (!insertRow(inserts->db, inserts->rating)) return false;
+
+		if (!countRow(inserts)) return false;
+	}
+
+	return true;
+}
+
+static bool insertGames(DatabaseInserts *inserts, std::vector<Game> games) {
+
+	for (Game game : games) {
+
+		Team home = game.getHomeTeam();
+		Team away = game.getAwayTeam();
+
+		bindText(inserts->game, 1, game.getGameID());
+		bindText(inserts->game, 2, home.getTeamID());
+		bindText(inserts->game, 3, away.getTeamID());
+		sqlite3_bind_int(inserts->game, 4, home.getScore());
+		sqlite3_bind_int(inserts->game, 5, away.getScore());
+
+		if (!insertRow(inserts->db, inserts->game)) return false;
+
+		if (!insertTeam(inserts, game.getGameID(), home) ||
+			!insertTeam(inserts, game.getGameID(), away)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool writeToDatabase(std::vector<Game> games, std::string path) {
+
+	DatabaseInserts inserts;
+
+	inserts.db = NULL;
+	inserts.game = NULL;
+	inserts.player = NULL;
+	inserts.rating = NULL;
+	inserts.rows = 0;
+
+	// Loaded into a new file, renamed over path only once it is complete
+	std::string tmpPath = path + ".tmp";
+
+	std::remove(tmpPath.c_str());
+
+	if (sqlite3_open(tmpPath.c_str(), &inserts.db) != SQLITE_OK) {
+		std::cerr << "Could not open " << tmpPath << std::endl;
+		sqlite3_close(inserts.db);
+		return false;
+	}
+
+	// A failed load is deleted, so no rollback journal is needed
+	bool written = execute(inserts.db,
+		"PRAGMA journal_mode = OFF; PRAGMA synchronous = OFF;") &&
+		execute(inserts.db, DATABASE_SCHEMA) &&
+		sqlite3_prepare_v2(inserts.db, INSERT_GAME, -1, &inserts.game,
+			NULL) == SQLITE_OK &&
+		sqlite3_prepare_v2(inserts.db, INSERT_PLAYER, -1, &inserts.player,
+			NULL) == SQLITE_OK &&
+		sqlite3_prepare_v2(inserts.db, INSERT_RATING, -1, &inserts.rating,
+			NULL) == SQLITE_OK &&
+		execute(inserts.db, "BEGIN") &&
+		insertGames(&inserts, games) &&
+		execute(inserts.db, "COMMIT") &&
+		execute(inserts.db, DATABASE_INDEXES);
+
+	if (!written) {
+		std::cerr << "Could not write " << path << ": "
+			<< sqlite3_errmsg(inserts.db) << std::endl;
+
+		// Still inside a batch transaction
+		if (!sqlite3_get_autocommit(inserts.db)) {
+			sqlite3_exec(inserts.db, "ROLLBACK", NULL, NULL, NULL);
+		}
+	}
+
+	sqlite3_finalize(inserts.game);
+	sqlite3_finalize(inserts.player);
+	sqlite3_finalize(inserts.rating);
+
+	written = sqlite3_close(inserts.db) == SQLITE_OK && written;
+
+	// A partial load never replaces the output
+	if (!written || std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+		std::remove(tmpPath.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+#else // BBALL_SQLITE
+
+bool writeToDatabase(std::vector<Game>, std::string) {
+	std::cerr << "bball was built without SQLite support" << std::endl;
+	return false;
+}
+
+#endif // BBALL_SQLITE
@@ -0,0 +1,23 @@
+/* SQLite Database Header */
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#ifndef DATABASE_H_
+#define DATABASE_H_
+
+#include "game.hpp"
+
+#include <string>
+#include <vector>
+
+
+// Rows inserted per transaction
+#define DATABASE_BATCH_SIZE	50000
+
+/// Write Games, Players and per-Game Player ratings to a new SQLite file
+// - Loads into path.tmp and renames it over path once complete, so a failed
+//   load leaves any earlier file in place. Returns false if the write
+//   failed or bball was built without SQLite.
+bool writeToDatabase(std::vector<Game> games, std::string path);
+
+#endif // DATABASE_H_
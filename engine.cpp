@@ -0,0 +1,450 @@
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#include "engine.hpp"
+#include "parallel.hpp"
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+
+/* Clean double quotes from data */
+std::string cleanString(std::string str) {
+
+	std::string cleaned;
+
+	for (int i = 0; i < str.length(); i++) {
+		if (str[i] != '"') cleaned.push_back(str[i]);
+	}
+
+	return cleaned;
+}
+
+/* Checks if File line contains header data */
+bool isValidLine(std::string line) {
+
+	std::size_t check = line.find("Game");
+
+	return check == std::string::npos;
+}
+
+/* Simulate vector of Games */
+std::vector<Game> simulateGames(std::vector<Game> gamesToPlay) {
+
+	std::vector<Game> playedGames;
+
+	for (Game currGame : gamesToPlay) {
+
+		currGame.simulateGame();
+
+		currGame.updateRosters();
+
+		playedGames.push_back(currGame);
+	}
+
+	return playedGames;
+}
+
+/* Simulate vector of Games across threads, feeding leaders */
+std::vector<Game> simulateGames(std::vector<Game> gamesToPlay,
+	Leaderboard *leaders, int threads, bool tables) {
+
+	threads = rangeCount(gamesToPlay.size(), threads);
+
+	// Worker boards share the settings of leaders, it keeps its own ratings
+	std::vector<Leaderboard> boards;
+
+	if (leaders != NULL) {
+		Leaderboard empty = *leaders;
+
+		empty.clear();
+
+		boards.assign(threads, empty);
+	}
+
+	parallelRanges(gamesToPlay.size(), threads,
+		[&gamesToPlay, &boards, tables](int thread, int begin, int end) {
+
+		for (int i = begin; i < end; i++) {
+
+			gamesToPlay[i].trackTables(tables);
+
+			gamesToPlay[i].simulateGame();
+
+			gamesToPlay[i].updateRosters();
+
+			if (!boards.empty()) boards[thread].addGame(&gamesToPlay[i]);
+		}
+	});
+
+	// Worker order, ranges are contiguous so boards follow Game order
+	for (Leaderboard &board : boards) leaders->merge(board);
+
+	return gamesToPlay;
+}
+
+/* Create an Event from Play line data */
+Event makeEvent(std::string playLine) {
+
+	std::stringstream strStream(playLine);
+
+	std::string playData;
+
+	std::vector<std::string> playTokens;
+
+	while (getline(strStream, playData, '\t')) {
+		playTokens.push_back(cleanString(playData));
+	}
+
+	int eventNumber = std::stoi(playTokens[EVENT_NUMBER]);
+	int eventType = std::stoi(playTokens[EVENT_TYPE]);
+	int period = std::stoi(playTokens[PLAY_PERIOD]);
+	int actionType = std::stoi(playTokens[ACTION_TYPE]);
+	int wcTime = std::stoi(playTokens[WC_TIME]);
+	int pcTime = std::stoi(playTokens[PC_TIME]);
+	int option = std::stoi(playTokens[OPTION1]);
+
+	std::string gameID = playTokens[PLAY_GAME_ID];
+	std::string player1ID = playTokens[PLAY_PERSON1];
+	std::string player2ID = playTokens[PLAY_PERSON2];
+	std::string player3ID = playTokens[PLAY_PERSON3];
+	std::string teamID = playTokens[PLAY_TEAM_ID];
+
+	playTokens.clear();
+
+	return Event(eventNumber, eventType, period, actionType, wcTime, pcTime,
+		option, Player(player1ID), Player(player2ID), Player(player3ID),
+		Team(teamID));
+}
+
+/* Read Event corrections by Game ID */
+std::map<std::string, std::vector<EventCorrection>> readCorrections(
+	std::istream *correctionStream) {
+
+	std::map<std::string, std::vector<EventCorrection>> corrections;
+
+	std::string line;
+
+	while (getline(*correctionStream, line)) {
+
+		std::size_t tab = line.find('\t');
+
+		if (tab == std::string::npos) continue;
+
+		std::string kind = line.substr(0, tab);
+		std::string rest = line.substr(tab + 1);
+
+		EventCorrection correction;
+		std::string gameID;
+
+		if (kind == CORRECTION_DELETE) {
+
+			std::stringstream strStream(rest);
+			std::string eventNumber;
+
+			getline(strStream, gameID, '\t');
+			getline(strStream, eventNumber, '\t');
+
+			correction.kind = EVENT_DELETE;
+			correction.eventNumber = std::stoi(cleanString(eventNumber));
+
+			gameID = cleanString(gameID);
+		}
+		else if (kind == CORRECTION_INSERT || kind == CORRECTION_AMEND) {
+
+			correction.kind = (kind == CORRECTION_INSERT) ? EVENT_INSERT :
+				EVENT_AMEND;
+			correction.event = makeEvent(rest);
+			correction.eventNumber = correction.event.getEventNumber();
+
+			gameID = cleanString(rest.substr(0, rest.find('\t')));
+		}
+		else continue;
+
+		corrections[gameID].push_back(correction);
+	}
+
+	return corrections;
+}
+
+/* Make vector of Games with all Play Events */
+std::vector<Game> getGameEvents(std::vector<Game> gamesToMake,
+	std::istream *playStream)
+{
+
+	std::vector<Game> madeGames;
+
+	for (Game game : gamesToMake) {
+
+		std::string playLine;
+
+		while (getline(*playStream, playLine)) {
+
+			if (isValidLine(playLine)) {
+
+				// Turn Play Data line into Event
+				Event currEvent = makeEvent(playLine);
+
+				game.addEvent(currEvent);
+
+				if (currEvent.isGameCompleted()) {
+					game.sortEvents();
+					madeGames.push_back(game);
+					break;
+				}
+			}
+		}
+
+	}
+
+	return madeGames;
+}
+
+/* Bench Players not on Team court */
+Team benchPlayers(Team team) {
+	for (Player player : team.getRoster()) {
+		if (!team.isOnCourt(player)) team.addToBench(player);
+	}
+
+	return team;
+}
+
+/* Tokenize Game data from Game line */
+std::vector<std::string> getGameData(std::string gameLine) {
+
+	std::stringstream strStream(gameLine);
+
+	std::string gameData;
+
+	std::vector<std::string> gameTokens;
+
+	while (getline(strStream, gameData, '\t')) {
+		gameTokens.push_back(cleanString(gameData));
+	}
+
+	return gameTokens;
+}
+
+/* Make Game from Game ID, Teams, and vector of starters */
+Game makeGame(std::string gameID, Team homeTeam, Team awayTeam,
+	std::vector<std::vector<Player>> starters) {
+
+	homeTeam = benchPlayers(homeTeam);
+	awayTeam = benchPlayers(awayTeam);
+
+	Game game = Game(gameID, homeTeam, awayTeam);
+
+	for (int i = 0; i < starters.size(); i++) {
+		game.addStarters(starters[i]);
+	}
+
+	return game;
+}
+
+/* Make Player from Player ID and set if active */
+Player makePlayer(std::vector<std::string> gameTokens) {
+
+	Player player(gameTokens[GAME_PLAYER_ID]);
+
+	if (gameTokens[STATUS] == "A") player.activate();
+
+	return player;
+}
+
+/* Return Team with new Player added to roster */
+Team addPlayerToRoster(Team team, std::vector<std::string> gameTokens) {
+
+	Player player = makePlayer(gameTokens);
+
+	team.addPlayer(player);
+
+	return team;
+}
+
+/* Make Team from Game ID and add first Player */
+Team makeTeam(std::vector<std::string> gameTokens) {
+
+	Team team(gameTokens[GAME_TEAM_ID]);
+
+	team = addPlayerToRoster(team, gameTokens);
+
+	return team;
+}
+
+/* Make Game rosters for both teams */
+// - First Team listed in Game File is "Home" Team by default
+std::vector<Game> makeRosters(std::istream *gameStream) {
+
+	std::vector<Game> games;
+
+	Game game;
+
+	Team homeTeam, awayTeam;
+
+	std::vector<std::vector<Player>> allStarters;
+	std::vector<Player> starters;
+
+	std::string gameID = "", homeTeamID = "", awayTeamID = "", playerID = "";
+
+	std::vector<std::string> gameTokens;
+
+	std::string gameLine;
+
+	while (getline(*gameStream, gameLine)) {
+
+		if (isValidLine(gameLine)) {
+
+			gameTokens = getGameData(gameLine);
+
+			if (gameID == "") gameID = gameTokens[GAME_GAME_ID];
+			// Make new Game if GameIDs dont match
+			else if (gameID != gameTokens[GAME_GAME_ID]) {
+
+				game = makeGame(gameID, homeTeam, awayTeam, allStarters);
+
+				allStarters.clear();
+
+				games.push_back(game);
+				gameID = gameTokens[GAME_GAME_ID];
+				homeTeamID = "", awayTeamID = "";
+			}
+
+			// Add all Players to respective roster
+			if (gameTokens[GAME_PERIOD] == PERIOD_NULL) {
+
+				if (homeTeamID == "") {
+					homeTeamID = gameTokens[GAME_TEAM_ID];
+					homeTeam = makeTeam(gameTokens);
+				}
+				else if (homeTeamID == gameTokens[GAME_TEAM_ID]) {
+					homeTeam = addPlayerToRoster(homeTeam, gameTokens);
+				}
+				else if (awayTeamID == "") {
+					awayTeamID = gameTokens[GAME_TEAM_ID];
+					awayTeam = makeTeam(gameTokens);
+				}
+				else if (awayTeamID == gameTokens[GAME_TEAM_ID]) {
+					awayTeam = addPlayerToRoster(awayTeam, gameTokens);
+				}
+			}
+			// Add starters to starter vector and add to court if first period
+			else {
+				if (homeTeamID == gameTokens[GAME_TEAM_ID]) {
+					if (gameTokens[GAME_PERIOD] == FIRST_PERIOD) {
+						homeTeam.addToCourt(Player(gameTokens[GAME_PLAYER_ID]));
+					}
+					starters.push_back(Player(gameTokens[GAME_PLAYER_ID]));
+				}
+				else if (awayTeamID == gameTokens[GAME_TEAM_ID]) {
+					if (gameTokens[GAME_PERIOD] == FIRST_PERIOD) {
+						awayTeam.addToCourt(Player(gameTokens[GAME_PLAYER_ID]));
+					}
+					starters.push_back(Player(gameTokens[GAME_PLAYER_ID]));
+				}
+
+				if (starters.size() == FULL_COURT) {
+					allStarters.push_back(starters);
+					starters.clear();
+				}
+			}
+			gameTokens.clear();
+		}
+	}
+
+	// Add last Game after all Game lines read
+	game = makeGame(gameID, homeTeam, awayTeam, allStarters);
+
+	games.push_back(game);
+
+	return games;
+}
+
+/* Write Player Off Rtg and Def Rtg to Data File */
+void writePlayerData(Player player, std::string gameID,
+	std::ostream *dataStream) {
+
+	std::string gid = "\"" + gameID + "\"";
+	std::string pid = "\"" + player.getPlayerID() + "\"";
+
+	int pointsFor = player.getPointsFor();
+	int pointsAgainst = player.getPointsAgainst();
+
+	int offPoss = player.getOffPossessions();
+	int defPoss = player.getDefPossessions();
+
+	// Ratings are zero without possessions, as in every other output
+	double oRating = perHundred(pointsFor, offPoss);
+	double dRating = perHundred(pointsAgainst, defPoss);
+
+	*dataStream << std::fixed << std::setprecision(1) << gid << ","
+		<< pid << "," << oRating << "," << dRating << std::endl;
+}
+
+/* Write Game Off Rtg & Def Rtg stats to Data File */
+void writeToDataFile(std::vector<Game> games, std::ostream *dataStream) {
+
+	*dataStream << "\"Game_id\",\"Person_id\",\"OffRtg\",\"DefRtg\""
+		<< std::endl;
+
+	for (Game game : games) {
+		for (Player player : game.getHomeTeam().getRoster()) {
+			writePlayerData(player, game.getGameID(), dataStream);
+		}
+		for (Player player : game.getAwayTeam().getRoster()) {
+			writePlayerData(player, game.getGameID(), dataStream);
+		}
+	}
+}
+
+/* Read, then simulate, every Game in Game and Play streams */
+std::vector<Game> runGames(std::istream *gameStream, std::istream *playStream) {
+
+	std::vector<Game> games = makeRosters(gameStream);
+
+	games = getGameEvents(games, playStream);
+
+	return simulateGames(games);
+}
+
+/* Read, then simulate across threads, every Game in Game and Play streams */
+std::vector<Game> runGames(std::istream *gameStream, std::istream *playStream,
+	Leaderboard *leaders, int threads, bool tables) {
+
+	std::vector<Game> games = makeRosters(gameStream);
+
+	games = getGameEvents(games, playStream);
+
+	return simulateGames(games, leaders, threads, tables);
+}
+
+/* Run Games from in-memory Game File and Play File contents */
+std::vector<Game> runGamesFromBuffers(std::string gameData,
+	std::string playData) {
+
+	std::istringstream gameStream(gameData);
+	std::istringstream playStream(playData);
+
+	return runGames(&gameStream, &playStream);
+}
+
+/* Run Games from Game File and Play File paths */
+std::vector<Game> runGamesFromFiles(std::string gamePath,
+	std::string playPath) {
+
+	std::ifstream gameFile(gamePath.c_str());
+	std::ifstream playFile(playPath.c_str());
+
+	if (!gameFile.is_open() || !playFile.is_open()) {
+		return std::vector<Game>();
+	}
+
+	return runGames(&gameFile, &playFile);
+}
+
+/* Print Player ratings of every Game to stdout */
+void printGames(std::vector<Game> games) {
+	for (Game game : games) {
+		game.printRatings();
+	}
+}
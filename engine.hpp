@@ -0,0 +1,134 @@
+/* BBall Engine Header */
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+// Public interface of the bball library. Game and Play data can come from
+// any stream, so callers may pass files, memory buffers, or sockets.
+
+#ifndef ENGINE_H_
+#define ENGINE_H_
+
+#include "event.hpp"
+#include "game.hpp"
+#include "leaders.hpp"
+#include "player.hpp"
+#include "team.hpp"
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+
+// Periods in Game File
+#define PERIOD_NULL		"0"
+#define FIRST_PERIOD	"1"
+
+// Number of Players per period in Game File
+#define FULL_COURT	10
+
+// Game File Token Values
+#define GAME_GAME_ID	0
+#define GAME_PERIOD		1
+#define GAME_PLAYER_ID	2
+#define GAME_TEAM_ID	3
+#define STATUS			4
+
+// Play File Token Values
+#define PLAY_GAME_ID	0
+#define EVENT_NUMBER	1
+#define EVENT_TYPE		2
+#define PLAY_PERIOD		3
+#define WC_TIME			4
+#define PC_TIME			5
+#define ACTION_TYPE		6
+#define OPTION1			7
+#define OPTION2			8
+#define OPTION3			9
+#define PLAY_TEAM_ID	10
+#define PLAY_PERSON1	11
+#define PLAY_PERSON2	12
+#define PLAY_PERSON3	13
+#define PLAY_TEAM_TYPE	14
+#define PERSON1_TYPE	15
+#define PERSON2_TYPE	16
+#define PERSON3_TYPE	17
+
+// Correction File Kinds
+#define CORRECTION_INSERT	"INSERT"
+#define CORRECTION_DELETE	"DELETE"
+#define CORRECTION_AMEND	"AMEND"
+
+// Engine version, part of every cached Game hash
+// - Change whenever simulation results change
+#define ENGINE_VERSION	"2.0"
+
+// Default File Names
+#define GAME_FILE	"Game_Lineup.txt"
+#define PLAY_FILE	"Play_by_Play.txt"
+#define DATA_FILE	"Kevin_M_Smith_Q1_BBALL.csv"
+
+/// Parsing Functions
+
+/// Clean double quotes from data
+std::string cleanString(std::string str);
+
+/// Checks if File line does not contain header data
+bool isValidLine(std::string line);
+
+/// Make Game rosters for both teams from Game File lines
+std::vector<Game> makeRosters(std::istream *gameStream);
+
+/// Add all Play Events to Games, in Play File order
+std::vector<Game> getGameEvents(std::vector<Game> gamesToMake,
+	std::istream *playStream);
+
+/// Create an Event from Play line data
+Event makeEvent(std::string playLine);
+
+/// Read Event corrections by Game ID, one per line
+// - "INSERT<tab>play line", "AMEND<tab>play line" (replaces the Event with
+//   the same number) or "DELETE<tab>game id<tab>event number"
+std::map<std::string, std::vector<EventCorrection>> readCorrections(
+	std::istream *correctionStream);
+
+/// Simulation Functions
+
+/// Simulate vector of Games and update rosters
+// - Only Player counters are kept, analytics tables are left empty
+std::vector<Game> simulateGames(std::vector<Game> gamesToPlay);
+
+/// Simulate Games across threads, adding each to leaders as it finishes
+// - Each worker fills its own Leaderboard, merged in worker order
+// - Leaders may be NULL. Analytics tables are filled only if tables is set.
+std::vector<Game> simulateGames(std::vector<Game> gamesToPlay,
+	Leaderboard *leaders, int threads, bool tables);
+
+/// Read, then simulate, every Game in Game and Play streams
+std::vector<Game> runGames(std::istream *gameStream, std::istream *playStream);
+
+/// Read, then simulate across threads, adding finished Games to leaders
+std::vector<Game> runGames(std::istream *gameStream, std::istream *playStream,
+	Leaderboard *leaders, int threads, bool tables);
+
+/// Run Games from in-memory Game File and Play File contents
+std::vector<Game> runGamesFromBuffers(std::string gameData,
+	std::string playData);
+
+/// Run Games from Game File and Play File paths, empty if either is missing
+std::vector<Game> runGamesFromFiles(std::string gamePath,
+	std::string playPath);
+
+/// Output Functions
+
+/// Write Player Off Rtg and Def Rtg line
+void writePlayerData(Player player, std::string gameID,
+	std::ostream *dataStream);
+
+/// Write Game Off Rtg & Def Rtg stats in Data File layout
+void writeToDataFile(std::vector<Game> games, std::ostream *dataStream);
+
+/// Print Player ratings of every Game to stdout
+void printGames(std::vector<Game> games);
+
+#endif // ENGINE_H_
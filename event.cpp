@@ -2,6 +2,19 @@
 // Version: May 30, 2019 <v2.0>
 
 #include "event.hpp"
+#include "codes.hpp"
+
+// Hard-coded action types must agree with Event_Codes.txt
+static_assert(findEventCode(FREE_THROW, FINAL_FREE_THROW_A)->finalFreeThrow &&
+	findEventCode(FREE_THROW, FINAL_FREE_THROW_B)->finalFreeThrow &&
+	findEventCode(FREE_THROW, FINAL_FREE_THROW_C)->finalFreeThrow,
+	"Final free throw action types do not match Event_Codes.txt");
+static_assert(hasEventCode(FOUL, SHOOTING_FOUL) &&
+	hasEventCode(FOUL, TECHNICAL_FOUL) &&
+	hasEventCode(FOUL, FLAGRANT_FOUL_A) &&
+	hasEventCode(FOUL, FLAGRANT_FOUL_B) &&
+	hasEventCode(TURNOVER, SHOTCLOCK_VIOLATION),
+	"Foul or turnover action types missing from Event_Codes.txt");
 
 // Event Constructor
 
@@ -29,6 +42,22 @@ int Event::getEventNumber() {
 	return eventNumber;
 }
 
+int Event::getEventType() {
+	return eventType;
+}
+
+int Event::getPeriod() {
+	return period;
+}
+
+int Event::getWCTime() {
+	return wcTime;
+}
+
+int Event::getActionType() {
+	return actionType;
+}
+
 int Event::getPCTime() {
 	return pcTime;
 }
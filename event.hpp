@@ -72,7 +72,11 @@ public:
 	/// Event Getters
 
 	int getEventNumber();
+	int getEventType();
+	int getPeriod();
+	int getWCTime();
 	int getPCTime();
+	int getActionType();
 	int getOption();
 
 	Player getPlayer1();
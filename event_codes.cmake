@@ -0,0 +1,105 @@
+# Compile Event_Codes.txt into the constexpr descriptor table event_codes.hpp
+# Usage: cmake -DINPUT=Event_Codes.txt -DOUTPUT=event_codes.hpp -P event_codes.cmake
+
+file(STRINGS ${INPUT} code_lines)
+
+set(codes "")
+set(keys "")
+set(max_type 0)
+set(max_action 0)
+set(count 0)
+
+foreach(line IN LISTS code_lines)
+  string(REGEX REPLACE "\r$" "" line "${line}")
+  string(REPLACE "\"" "" line "${line}")
+  string(REPLACE "\t" ";" fields "${line}")
+
+  list(LENGTH fields field_count)
+  if(field_count LESS 4)
+    continue()
+  endif()
+
+  list(GET fields 0 type)
+  list(GET fields 1 action)
+  list(GET fields 2 event_name)
+  list(GET fields 3 action_name)
+
+  # Skip header line
+  if(NOT type MATCHES "^[0-9]+$" OR NOT action MATCHES "^[0-9]+$")
+    continue()
+  endif()
+
+  string(STRIP "${event_name}" event_name)
+  string(STRIP "${action_name}" action_name)
+
+  if(action_name STREQUAL "NA")
+    set(action_name "")
+  endif()
+
+  # Shot family of made and missed shots
+  set(shot SHOT_NONE)
+  if(type EQUAL 1 OR type EQUAL 2)
+    if(action_name MATCHES "Dunk")
+      set(shot SHOT_DUNK)
+    elseif(action_name MATCHES "Layup|Finger Roll")
+      set(shot SHOT_LAYUP)
+    elseif(action_name MATCHES "Tip")
+      set(shot SHOT_TIP)
+    elseif(action_name MATCHES "Hook")
+      set(shot SHOT_HOOK)
+    elseif(NOT action_name MATCHES "No Shot")
+      set(shot SHOT_JUMP)
+    endif()
+  endif()
+
+  # Last free throw of a trip, "N of N"
+  set(final false)
+  if(type EQUAL 3 AND action_name MATCHES "([0-9]) of ([0-9])$")
+    if(CMAKE_MATCH_1 EQUAL CMAKE_MATCH_2)
+      set(final true)
+    endif()
+  endif()
+
+  set(codes "${codes}\t{ ${type}, ${action}, \"${event_name}\", \"${action_name}\", ${shot}, ${final} },\n")
+  list(APPEND keys "${type}:${action}")
+
+  if(type GREATER max_type)
+    set(max_type ${type})
+  endif()
+  if(action GREATER max_action)
+    set(max_action ${action})
+  endif()
+
+  math(EXPR count "${count} + 1")
+endforeach()
+
+math(EXPR type_count "${max_type} + 1")
+math(EXPR action_count "${max_action} + 1")
+
+# Dense (type, action) to descriptor position, -1 where no code exists
+set(index "")
+foreach(type RANGE ${max_type})
+  set(row "")
+  foreach(action RANGE ${max_action})
+    list(FIND keys "${type}:${action}" position)
+    set(row "${row}${position}, ")
+  endforeach()
+  string(REGEX REPLACE ", $" "" row "${row}")
+  set(index "${index}\t{ ${row} },\n")
+endforeach()
+
+file(WRITE ${OUTPUT}
+"/* Event Codes Table, generated from Event_Codes.txt by event_codes.cmake */\n"
+"// Do not edit, included by codes.hpp\n\n"
+"#ifndef EVENT_CODES_H_\n"
+"#define EVENT_CODES_H_\n\n"
+"#define EVENT_CODE_COUNT\t${count}\n"
+"#define EVENT_CODE_TYPES\t${type_count}\n"
+"#define EVENT_CODE_ACTIONS\t${action_count}\n\n"
+"static constexpr EventCode EVENT_CODES[EVENT_CODE_COUNT] = {\n"
+"${codes}"
+"};\n\n"
+"static constexpr short EVENT_CODE_INDEX[EVENT_CODE_TYPES][EVENT_CODE_ACTIONS] = {\n"
+"${index}"
+"};\n\n"
+"#endif // EVENT_CODES_H_\n")
@@ -14,6 +14,21 @@ Game::Game(std::string gid, Team ht, Team at) {
 
 	period = 1;
 
+	clockPeriod = 0;
+	clockTime = 0;
+
+	possessionStart = 0;
+
+	waitToSub = false;
+	waitForRebound = false;
+
+	simulated = 0;
+
+	tables = false;
+
+	homeCell = cubeCell(1, 0, 0);
+	awayCell = cubeCell(1, 0, 0);
+
 	lastPossession = Event();
 	lastPossessionTeam = Team();
 }
@@ -36,8 +51,93 @@ std::vector<Event> Game::getGameEvents() {
 	return events;
 }
 
+const LineupTable &Game::getHomeLineups() {
+	return homeLineups;
+}
+
+const LineupTable &Game::getAwayLineups() {
+	return awayLineups;
+}
+
+const OnOffTable &Game::getHomeOnOff() {
+	return homeOnOff;
+}
+
+const OnOffTable &Game::getAwayOnOff() {
+	return awayOnOff;
+}
+
+const PairTable &Game::getHomePairs() {
+	return homePairs;
+}
+
+const PairTable &Game::getAwayPairs() {
+	return awayPairs;
+}
+
+const MatchupTable &Game::getMatchups() {
+	return matchups;
+}
+
+const CubeTable &Game::getHomeCube() {
+	return homeCube;
+}
+
+const CubeTable &Game::getAwayCube() {
+	return awayCube;
+}
+
+const BoxScoreTable &Game::getHomeBox() {
+	return homeBox;
+}
+
+const BoxScoreTable &Game::getAwayBox() {
+	return awayBox;
+}
+
+const ShotTable &Game::getHomeShots() {
+	return homeShots;
+}
+
+const ShotTable &Game::getAwayShots() {
+	return awayShots;
+}
+
+const PaceTable &Game::getHomePace() {
+	return homePace;
+}
+
+const PaceTable &Game::getAwayPace() {
+	return awayPace;
+}
+
+const std::vector<Stint> &Game::getStints() {
+	return stints.getStints();
+}
+
+const std::vector<PossessionRecord> &Game::getPossessions() {
+	return possessions.getPossessions();
+}
+
 //	Game Functions
 
+void Game::trackTables(bool track) {
+	tables = track;
+
+	if (!tables) return;
+
+	homePairs = PairTable(homeTeam.getTeamSize());
+	awayPairs = PairTable(awayTeam.getTeamSize());
+
+	matchups = MatchupTable(homeTeam.getTeamSize(), awayTeam.getTeamSize());
+
+	homeCube = CubeTable(homeTeam.getTeamSize());
+	awayCube = CubeTable(awayTeam.getTeamSize());
+
+	homeShots = ShotTable(homeTeam.getTeamSize());
+	awayShots = ShotTable(awayTeam.getTeamSize());
+}
+
 void Game::addEvent(Event ev) {
 	events.push_back(ev);
 }
@@ -50,6 +150,10 @@ void Game::sortEvents() {
 	std::sort(events.begin(), events.end());
 }
 
+void Game::clearEvents() {
+	std::vector<Event>().swap(events);
+}
+
 void Game::updateRosters() {
 	homeTeam.updateRoster();
 	awayTeam.updateRoster();
@@ -58,11 +162,51 @@ void Game::updateRosters() {
 void Game::homeScore(int points) {
 	homeTeam.score(points);
 	awayTeam.scoredOn(points);
+
+	if (!tables) return;
+
+	homeLineups.score(homeTeam.getLineupKey(), points);
+	awayLineups.scoredOn(awayTeam.getLineupKey(), points);
+
+	homeOnOff.score(homeTeam.getCourtMask(), points);
+	awayOnOff.scoredOn(awayTeam.getCourtMask(), points);
+
+	homePairs.score(homeTeam.getCourtMask(), points);
+	awayPairs.scoredOn(awayTeam.getCourtMask(), points);
+
+	matchups.homeScore(homeTeam.getCourtMask(), awayTeam.getCourtMask(),
+		points);
+
+	homeCube.score(homeTeam.getCourtMask(), homeCell, points);
+	awayCube.scoredOn(awayTeam.getCourtMask(), awayCell, points);
+
+	stints.homeScore(points);
+	possessions.homeScore(points);
 }
 
 void Game::awayScore(int points) {
 	awayTeam.score(points);
 	homeTeam.scoredOn(points);
+
+	if (!tables) return;
+
+	awayLineups.score(awayTeam.getLineupKey(), points);
+	homeLineups.scoredOn(homeTeam.getLineupKey(), points);
+
+	awayOnOff.score(awayTeam.getCourtMask(), points);
+	homeOnOff.scoredOn(homeTeam.getCourtMask(), points);
+
+	awayPairs.score(awayTeam.getCourtMask(), points);
+	homePairs.scoredOn(homeTeam.getCourtMask(), points);
+
+	matchups.awayScore(homeTeam.getCourtMask(), awayTeam.getCourtMask(),
+		points);
+
+	awayCube.score(awayTeam.getCourtMask(), awayCell, points);
+	homeCube.scoredOn(homeTeam.getCourtMask(), homeCell, points);
+
+	stints.awayScore(points);
+	possessions.awayScore(points);
 }
 
 void Game::endOfHomePossession() {
@@ -70,6 +214,31 @@ void Game::endOfHomePossession() {
 	awayTeam.defPossession();
 
 	lastPossessionTeam = homeTeam;
+
+	if (!tables) return;
+
+	homeLineups.offPossession(homeTeam.getLineupKey());
+	awayLineups.defPossession(awayTeam.getLineupKey());
+
+	homeOnOff.offPossession(homeTeam.getCourtMask());
+	awayOnOff.defPossession(awayTeam.getCourtMask());
+
+	homePairs.offPossession(homeTeam.getCourtMask());
+	awayPairs.defPossession(awayTeam.getCourtMask());
+
+	matchups.homePossession(homeTeam.getCourtMask(),
+		awayTeam.getCourtMask());
+
+	homeCube.offPossession(homeTeam.getCourtMask(), homeCell);
+	awayCube.defPossession(awayTeam.getCourtMask(), awayCell);
+
+	homePace.possession(possessionDuration());
+
+	stints.homePossession();
+	possessions.homePossession(homeTeam.getCourtMask(),
+		awayTeam.getCourtMask());
+
+	updateCubeCells();
 }
 
 void Game::endOfAwayPossession() {
@@ -77,6 +246,31 @@ void Game::endOfAwayPossession() {
 	awayTeam.offPossession();
 
 	lastPossessionTeam = awayTeam;
+
+	if (!tables) return;
+
+	homeLineups.defPossession(homeTeam.getLineupKey());
+	awayLineups.offPossession(awayTeam.getLineupKey());
+
+	homeOnOff.defPossession(homeTeam.getCourtMask());
+	awayOnOff.offPossession(awayTeam.getCourtMask());
+
+	homePairs.defPossession(homeTeam.getCourtMask());
+	awayPairs.offPossession(awayTeam.getCourtMask());
+
+	matchups.awayPossession(homeTeam.getCourtMask(),
+		awayTeam.getCourtMask());
+
+	homeCube.defPossession(homeTeam.getCourtMask(), homeCell);
+	awayCube.offPossession(awayTeam.getCourtMask(), awayCell);
+
+	awayPace.possession(possessionDuration());
+
+	stints.awayPossession();
+	possessions.awayPossession(homeTeam.getCourtMask(),
+		awayTeam.getCourtMask());
+
+	updateCubeCells();
 }
 
 void Game::subPossession(Player player) {
@@ -101,10 +295,133 @@ void Game::subPossession(Player player) {
 
 void Game::homeSubstitution(Player out, Player in) {
 	homeTeam.substitute(out, in);
+
+	changeStint();
 }
 
 void Game::awaySubstitution(Player out, Player in) {
 	awayTeam.substitute(out, in);
+
+	changeStint();
+}
+
+void Game::changeStint() {
+
+	if (!tables) return;
+
+	stints.start(homeTeam.getCourtMask(), awayTeam.getCourtMask(),
+		clockPeriod, clockTime);
+}
+
+void Game::addToBox(Player player, int counter) {
+
+	int slot = homeTeam.findSlot(player);
+
+	if (slot != NO_SLOT) {
+		homeBox.add(slot, counter);
+		return;
+	}
+
+	slot = awayTeam.findSlot(player);
+
+	if (slot != NO_SLOT) awayBox.add(slot, counter);
+}
+
+void Game::addShot(Player player, int actionType, int points) {
+
+	int slot = homeTeam.findSlot(player);
+
+	if (slot != NO_SLOT) {
+		homeShots.shot(slot, actionType, points);
+		return;
+	}
+
+	slot = awayTeam.findSlot(player);
+
+	if (slot != NO_SLOT) awayShots.shot(slot, actionType, points);
+}
+
+void Game::countBoxScore(Event ev, Event lastEv) {
+
+	if (!tables) return;
+
+	Player player = ev.getPlayer1();
+
+	if (ev.isMadeShot()) {
+		addShot(player, ev.getActionType(), ev.getOption());
+
+		if (ev.getOption() == THREE_POINTS) {
+			addToBox(player, BOX_FGM3);
+			addToBox(player, BOX_FGA3);
+		}
+		else {
+			addToBox(player, BOX_FGM2);
+			addToBox(player, BOX_FGA2);
+		}
+	}
+	else if (ev.isMissedShot()) {
+		addShot(player, ev.getActionType(), 0);
+		if (ev.getOption() == THREE_POINTS) addToBox(player, BOX_FGA3);
+		else addToBox(player, BOX_FGA2);
+	}
+	else if (ev.isFreeThrow()) {
+		if (ev.isMadeFreeThrow()) addToBox(player, BOX_FTM);
+		addToBox(player, BOX_FTA);
+	}
+	else if (ev.isRebound()) {
+		// Team rebounds have no Player on either roster
+		bool homeRebound = homeTeam.hasPlayer(player);
+		bool homeShooter = homeTeam.hasPlayer(lastEv.getPlayer1());
+		bool awayShooter = awayTeam.hasPlayer(lastEv.getPlayer1());
+
+		if ((homeRebound && homeShooter) || (!homeRebound && awayShooter)) {
+			addToBox(player, BOX_OREB);
+		}
+		else addToBox(player, BOX_DREB);
+	}
+	else if (ev.isTurnover()) {
+		addToBox(player, BOX_TOV);
+	}
+	else if (ev.isFoul()) {
+		addToBox(player, BOX_FOULS);
+	}
+	else if (ev.isSubstitution()) {
+		addToBox(player, BOX_SUBS_OUT);
+		addToBox(ev.getPlayer2(), BOX_SUBS_IN);
+	}
+}
+
+void Game::advanceClock(Event ev) {
+
+	int elapsed = clockTime - ev.getPCTime();
+
+	// Clock restarts each period, nothing is played between periods
+	if (tables && ev.getPeriod() == clockPeriod && elapsed > 0) {
+		homePace.play(homeTeam.getCourtMask(), elapsed);
+		awayPace.play(awayTeam.getCourtMask(), elapsed);
+	}
+
+	clockPeriod = ev.getPeriod();
+	clockTime = ev.getPCTime();
+}
+
+int Game::possessionDuration() {
+
+	int duration = possessionStart - clockTime;
+
+	possessionStart = clockTime;
+
+	return duration;
+}
+
+void Game::updateCubeCells() {
+
+	if (!tables) return;
+
+	int margin = homeTeam.getScore() - awayTeam.getScore();
+
+	homeCell = cubeCell(clockPeriod, margin, clockTime);
+	awayCell = cubeCell(clockPeriod, -margin, clockTime);
 }
 
 void Game::addToSubBuffer(Player out, Player in) {
@@ -162,6 +479,8 @@ void Game::updateStarters() {
 			}
 		}
 	}
+
+	changeStint();
 }
 
 void Game::handleMadeShot(Event ev) {
@@ -446,59 +765,430 @@ void Game::handleEndPossession(Event ev, Event lastEv, Event nextEv, int i) {
 
 void Game::simulateGame() {
 
-	bool waitToSub = false, waitForRebound = false;
+	startSimulation();
 
-	Event currEvent, lastEvent, nextEvent;
+	simulateFrom(0);
+}
 
-	for (int i = 0; i < events.size(); i++) {
+void Game::startSimulation() {
 
-		currEvent = events[i];
+	waitToSub = false;
+	waitForRebound = false;
 
-		if (i > 0) lastEvent = events[i - 1];
-		else lastEvent = Event();
+	simulated = 0;
 
-		if (i + 1 < events.size()) nextEvent = events[i + 1];
-		else nextEvent = Event();
+	snapshots.clear();
 
-		if (currEvent.isUnknownRebound(homeTeam, awayTeam) &&
-			lastEvent.isMissedShot()) {
+	if (!events.empty()) {
+		clockPeriod = events[0].getPeriod();
+		clockTime = events[0].getPCTime();
+		possessionStart = clockTime;
+	}
 
-			handleUnknownRebound(currEvent, lastEvent, nextEvent, i + 1);
-			continue;
-		}
+	changeStint();
+	updateCubeCells();
+}
 
-		if (currEvent.isEndPossession(lastEvent, homeTeam, awayTeam)) {
-			handleEndPossession(currEvent, lastEvent, nextEvent, i);
-		}
+void Game::simulateFrom(int first) {
 
-		if (currEvent.isFreeThrow() && !currEvent.isFinalFreeThrow()) {
-			handleFreeThrow(currEvent);
-		}
+	simulated = first;
+
+	while (simulated < events.size()) simulateNext();
+
+	finishSimulation();
+}
+
+void Game::simulateNext() {
+
+	int i = simulated;
+
+	if (i % SNAPSHOT_INTERVAL == 0 || events[i].isStartPeriod()) {
+		snapshots.push_back(takeSnapshot(i));
+	}
+
+	simulateEvent(i);
+
+	simulated++;
+}
+
+void Game::finishSimulation() {
+	if (tables) stints.finish(clockPeriod, clockTime);
+}
+
+void Game::simulateEvent(int i) {
+
+	Event currEvent = events[i], lastEvent, nextEvent;
+
+	advanceClock(currEvent);
+
+	// Courts set at the end of last period take the floor now
+	if (currEvent.isStartPeriod()) {
+		possessionStart = clockTime;
+
+		changeStint();
+		updateCubeCells();
+	}
+
+	if (i > 0) lastEvent = events[i - 1];
+	else lastEvent = Event();
+
+	if (i + 1 < events.size()) nextEvent = events[i + 1];
+	else nextEvent = Event();
+
+	countBoxScore(currEvent, lastEvent);
+
+	if (currEvent.isUnknownRebound(homeTeam, awayTeam) &&
+		lastEvent.isMissedShot()) {
+
+		handleUnknownRebound(currEvent, lastEvent, nextEvent, i + 1);
+		return;
+	}
+
+	if (currEvent.isEndPossession(lastEvent, homeTeam, awayTeam)) {
+		handleEndPossession(currEvent, lastEvent, nextEvent, i);
+	}
+
+	if (currEvent.isFreeThrow() && !currEvent.isFinalFreeThrow()) {
+		handleFreeThrow(currEvent);
+	}
 
-		if (waitForRebound && currEvent.isRebound()) {
+	if (waitForRebound && currEvent.isRebound()) {
+		waitToSub = false;
+		waitForRebound = false;
+
+		pushSubBuffer();
+	}
+
+	if (waitToSub && currEvent.isFinalFreeThrow()) {
+		// Add Player to court after made FT
+		if (currEvent.isMadeFreeThrow()) {
 			waitToSub = false;
-			waitForRebound = false;
 
 			pushSubBuffer();
 		}
+		else waitForRebound = true;
+	}
+
+	if (currEvent.isSubstitution()) {
+		// Sub Handle returns if sub buffer is used
+		waitToSub = handleSubstitution(currEvent, lastEvent, nextEvent,
+			i, waitToSub);
+	}
+}
+
+bool Game::canSimulate(int i, bool complete) {
+
+	if (complete) return i < events.size();
+
+	if (i + 1 >= events.size()) return false;
+
+	Event currEvent = events[i], nextEvent = events[i + 1];
+
+	// Unknown rebound reads ahead to the next Player Event of the period
+	if (i > 0 && currEvent.isUnknownRebound(homeTeam, awayTeam) &&
+		events[i - 1].isMissedShot() && !nextEvent.isShotclockViolation()) {
+
+		for (int j = i + 1; j < events.size(); j++) {
+
+			Player player1 = events[j].getPlayer1();
+
+			if (events[j].isEndPeriod()) return true;
+
+			if ((homeTeam.hasPlayer(player1) || awayTeam.hasPlayer(player1))
+				&& unknownReboundCheck(events[j])) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	// Substitution block reads ahead to the first Event after it
+	if (currEvent.isSubstitution() && nextEvent.isSubstitution()) {
+
+		for (int j = i + 2; j < events.size(); j++) {
+			if (!events[j].isSubstitution()) return true;
+		}
+
+		return false;
+	}
+
+	return true;
+}
+
+int Game::advance(bool complete) {
+
+	int first = simulated;
+
+	while (canSimulate(simulated, complete)) simulateNext();
+
+	return simulated - first;
+}
+
+bool Game::insertLateEvent(Event ev) {
+
+	int pos = events.size();
+
+	while (pos > 0 && ev < events[pos - 1]) pos--;
+
+	events.insert(events.begin() + pos, ev);
+
+	// Not simulated yet, it is played in order with the rest
+	if (pos >= simulated) return true;
+
+	// Events before the period are unchanged, state at its start holds
+	int start = 0;
+
+	while (start < pos && events[start].getPeriod() < ev.getPeriod()) {
+		start++;
+	}
+
+	int s = snapshots.size() - 1;
+
+	while (s > 0 && snapshots[s].eventIndex > start) s--;
+
+	// The first Event always gets a snapshot, so this means state was lost
+	if (snapshots.empty() || snapshots[s].eventIndex > start) {
+		std::cerr << "Game " << gameID << ": no snapshot before late event "
+			<< ev.getEventNumber() << ", cannot re-simulate it" << std::endl;
+		return false;
+	}
+
+	restoreSnapshot(snapshots[s]);
+
+	simulated = snapshots[s].eventIndex;
+
+	snapshots.erase(snapshots.begin() + s, snapshots.end());
+
+	return true;
+}
+
+int Game::getSimulated() {
+	return simulated;
+}
+
+GameSnapshot Game::takeSnapshot(int i) {
+
+	GameSnapshot snapshot;
+
+	snapshot.eventIndex = i;
+
+	snapshot.homeTeam = homeTeam.saveState();
+	snapshot.awayTeam = awayTeam.saveState();
+
+	snapshot.subBufferOut = subBufferOut;
+	snapshot.subBufferIn = subBufferIn;
+
+	snapshot.lastPossession = lastPossession;
 
-		if (waitToSub && currEvent.isFinalFreeThrow()) {
-			// Add Player to court after made FT
-			if (currEvent.isMadeFreeThrow()) {
-				waitToSub = false;
+	if (lastPossessionTeam == homeTeam) {
+		snapshot.lastPossessionSide = POSSESSION_HOME;
+	}
+	else if (lastPossessionTeam == awayTeam) {
+		snapshot.lastPossessionSide = POSSESSION_AWAY;
+	}
+	else snapshot.lastPossessionSide = POSSESSION_NONE;
+
+	snapshot.period = period;
+	snapshot.clockPeriod = clockPeriod;
+	snapshot.clockTime = clockTime;
+	snapshot.possessionStart = possessionStart;
+
+	snapshot.waitToSub = waitToSub;
+	snapshot.waitForRebound = waitForRebound;
+
+	return snapshot;
+}
+
+void Game::restoreSnapshot(GameSnapshot snapshot) {
+
+	homeTeam.restoreState(snapshot.homeTeam);
+	awayTeam.restoreState(snapshot.awayTeam);
+
+	subBufferOut = snapshot.subBufferOut;
+	subBufferIn = snapshot.subBufferIn;
+
+	lastPossession = snapshot.lastPossession;
+
+	if (snapshot.lastPossessionSide == POSSESSION_HOME) {
+		lastPossessionTeam = homeTeam;
+	}
+	else if (snapshot.lastPossessionSide == POSSESSION_AWAY) {
+		lastPossessionTeam = awayTeam;
+	}
+	else lastPossessionTeam = Team();
+
+	period = snapshot.period;
+	clockPeriod = snapshot.clockPeriod;
+	clockTime = snapshot.clockTime;
+	possessionStart = snapshot.possessionStart;
+
+	waitToSub = snapshot.waitToSub;
+	waitForRebound = snapshot.waitForRebound;
+}
+
+bool Game::seek(int period, int pcTime, GameState *state) {
+
+	if (snapshots.empty()) return false;
+
+	// Events are sorted by period, then PC Time counting down
+	int end = 0;
+
+	while (end < events.size() && (events[end].getPeriod() < period ||
+		(events[end].getPeriod() == period &&
+		events[end].getPCTime() >= pcTime))) {
+		end++;
+	}
+
+	int s = snapshots.size() - 1;
+
+	while (s > 0 && snapshots[s].eventIndex > end) s--;
+
+	// Replay in a scratch Game, its analytics tables are discarded
+	Game replay(gameID, homeTeam, awayTeam);
+
+	replay.events.swap(events); // Lent for the replay, not copied
+	replay.starters = starters;
+
+	replay.restoreSnapshot(snapshots[s]);
+
+	for (int i = snapshots[s].eventIndex; i < end; i++) {
+		replay.simulateEvent(i);
+	}
+
+	events.swap(replay.events);
+
+	replay.updateRosters();
+
+	state->period = period;
+	state->pcTime = pcTime;
+	state->homeTeam = replay.homeTeam;
+	state->awayTeam = replay.awayTeam;
+
+	return true;
+}
+
+/* Index of Event with number, -1 if missing */
+static int findEventNumber(std::vector<Event> *events, int eventNumber) {
+
+	for (int i = 0; i < events->size(); i++) {
+		if ((*events)[i].getEventNumber() == eventNumber) return i;
+	}
+
+	return -1;
+}
+
+/* Append deltas of every roster Player whose counters changed */
+static void addCounterDeltas(Team before, Team after,
+	std::vector<CounterDelta> *deltas) {
 
-				pushSubBuffer();
+	for (Player old : before.getRoster()) {
+		for (Player now : after.getRoster()) {
+
+			if (!(now == old)) continue;
+
+			CounterDelta delta;
+
+			delta.playerID = old.getPlayerID();
+			delta.teamID = before.getTeamID();
+
+			delta.pointsFor = now.getPointsFor() - old.getPointsFor();
+			delta.pointsAgainst = now.getPointsAgainst() -
+				old.getPointsAgainst();
+			delta.offPossessions = now.getOffPossessions() -
+				old.getOffPossessions();
+			delta.defPossessions = now.getDefPossessions() -
+				old.getDefPossessions();
+
+			if (delta.pointsFor != 0 || delta.pointsAgainst != 0 ||
+				delta.offPossessions != 0 || delta.defPossessions != 0) {
+				deltas->push_back(delta);
 			}
-			else waitForRebound = true;
+			break;
 		}
+	}
+}
+
+int Game::amendEvents(std::vector<EventCorrection> corrections,
+	std::vector<CounterDelta> *deltas) {
+
+	if (snapshots.empty()) return 0;
 
-		if (currEvent.isSubstitution()) {
-			// Sub Handle returns if sub buffer is used
-			waitToSub = handleSubstitution(currEvent, lastEvent, nextEvent,
-				i, waitToSub);
+	std::vector<Event> corrected = events;
+
+	int firstPeriod = -1;
+
+	for (EventCorrection correction : corrections) {
+
+		int touched = correction.event.getPeriod();
+
+		if (correction.kind != EVENT_INSERT) {
+
+			int i = findEventNumber(&corrected, correction.eventNumber);
+
+			if (i < 0) return 0;
+
+			touched = corrected[i].getPeriod();
+
+			if (correction.kind == EVENT_DELETE) {
+				corrected.erase(corrected.begin() + i);
+			}
+			else {
+				touched = std::min(touched, correction.event.getPeriod());
+				corrected[i] = correction.event;
+			}
 		}
+		else corrected.push_back(correction.event);
 
+		if (firstPeriod < 0 || touched < firstPeriod) firstPeriod = touched;
 	}
+
+	if (firstPeriod < 0) return 0;
+
+	std::sort(corrected.begin(), corrected.end());
+
+	// Events before the period are unchanged, and no handler looks across a
+	// period boundary, so state at the period start still holds
+	int start = 0;
+
+	while (start < events.size() && events[start].getPeriod() < firstPeriod) {
+		start++;
+	}
+
+	int s = snapshots.size() - 1;
+
+	while (s > 0 && snapshots[s].eventIndex > start) s--;
+
+	// Replay the corrected Events in a scratch Game, keeping its snapshots
+	Game replay(gameID, homeTeam, awayTeam);
+
+	replay.events.swap(corrected);
+	replay.starters = starters;
+
+	replay.restoreSnapshot(snapshots[s]);
+	replay.simulateFrom(snapshots[s].eventIndex);
+
+	replay.updateRosters();
+
+	addCounterDeltas(homeTeam, replay.homeTeam, deltas);
+	addCounterDeltas(awayTeam, replay.awayTeam, deltas);
+
+	snapshots.erase(snapshots.begin() + s, snapshots.end());
+	snapshots.insert(snapshots.end(), replay.snapshots.begin(),
+		replay.snapshots.end());
+
+	events.swap(replay.events);
+
+	homeTeam = replay.homeTeam;
+	awayTeam = replay.awayTeam;
+
+	return firstPeriod;
+}
+
+double perHundred(int points, int possessions) {
+	if (possessions == 0) return 0.0;
+
+	return (points / (double)possessions) * ONE_HUNDRED_POSSESSIONS;
 }
 
 /* Helper to generate stats for Player */
@@ -5,7 +5,17 @@
 #ifndef GAME_H_
 #define GAME_H_
 
+#include "bootstrap.hpp"
+#include "box.hpp"
+#include "cube.hpp"
 #include "event.hpp"
+#include "lineup.hpp"
+#include "matchup.hpp"
+#include "onoff.hpp"
+#include "pace.hpp"
+#include "pair.hpp"
+#include "shots.hpp"
+#include "stint.hpp"
 #include "team.hpp"
 
 #include <algorithm>
@@ -16,12 +26,76 @@
 
 #define ONE_HUNDRED_POSSESSIONS	100.0
 
+// Game Snapshot Values
+#define SNAPSHOT_INTERVAL	64	// Events between snapshots within a period
+#define POSSESSION_NONE		0	// No possession has ended yet
+#define POSSESSION_HOME		1
+#define POSSESSION_AWAY		2
+
+// Event Correction Kinds
+#define EVENT_INSERT	0
+#define EVENT_DELETE	1
+#define EVENT_AMEND		2
+
+/// Points per one hundred possessions, zero without possessions
+double perHundred(int points, int possessions);
+
+/* Simulation state before one Event, enough to resume from that Event */
+// - Teams are kept as TeamState, analytics tables are not saved
+struct GameSnapshot {
+	int eventIndex;	// First Event not yet simulated
+
+	TeamState homeTeam;
+	TeamState awayTeam;
+
+	std::vector<Player> subBufferOut;
+	std::vector<Player> subBufferIn;
+
+	Event lastPossession;
+	int lastPossessionSide;	// POSSESSION_NONE, _HOME or _AWAY
+
+	int period;
+	int clockPeriod;
+	int clockTime;
+	int possessionStart;
+
+	bool waitToSub;
+	bool waitForRebound;
+};
+
+/* Teams of a Game as they stood at one moment */
+struct GameState {
+	int period;
+	int pcTime;
+
+	Team homeTeam;	// Roster counters are up to date
+	Team awayTeam;
+};
+
+/* One league correction to a Game's play-by-play */
+struct EventCorrection {
+	int kind;			// EVENT_INSERT, EVENT_DELETE or EVENT_AMEND
+	int eventNumber;	// Event deleted or amended
+	Event event;		// Event inserted, or amended Event
+};
+
+/* Change to one Player's counters made by amending Events */
+struct CounterDelta {
+	std::string playerID;
+	std::string teamID;
+
+	int pointsFor;
+	int pointsAgainst;
+	int offPossessions;
+	int defPossessions;
+};
+
 /* Represents Game with two Teams */
 class Game {
 
 public:
 
-	Game() {}; // Default
+	Game() { tables = false; }; // Default
 
 	/// Construct Game with ID and Home and Away Teams
 	Game(std::string gid, Team ht, Team at);
@@ -35,8 +109,41 @@ public:
 
 	std::vector<Event> getGameEvents();
 
+	/// Analytics tables, empty unless filled by trackTables
+
+	const LineupTable &getHomeLineups();
+	const LineupTable &getAwayLineups();
+
+	const OnOffTable &getHomeOnOff();
+	const OnOffTable &getAwayOnOff();
+
+	const PairTable &getHomePairs();
+	const PairTable &getAwayPairs();
+
+	const MatchupTable &getMatchups();
+
+	const CubeTable &getHomeCube();
+	const CubeTable &getAwayCube();
+
+	const BoxScoreTable &getHomeBox();
+	const BoxScoreTable &getAwayBox();
+
+	const ShotTable &getHomeShots();
+	const ShotTable &getAwayShots();
+
+	const PaceTable &getHomePace();
+	const PaceTable &getAwayPace();
+
+	const std::vector<Stint> &getStints();
+
+	const std::vector<PossessionRecord> &getPossessions();
+
 	/// Game Functions
 
+	/// Fill analytics tables while simulating, sizing them for the rosters
+	// - Off by default, Player counters are always kept
+	void trackTables(bool track);
+
 	/// Add Event to Events vector
 	void addEvent(Event ev);
 	/// Add starting Players vector to starters vector
@@ -45,6 +152,9 @@ public:
 	/// Sort Events by period, PC Time, WC Time, then number
 	void sortEvents();
 
+	/// Drop every Event and release their memory
+	void clearEvents();
+
 	/// Add Players to roster with calculated data
 	void updateRosters();
 
@@ -65,12 +175,88 @@ public:
 	/// Add buffered Players to Game
 	void pushSubBuffer();
 
+	/// Start a new stint with the current courts at the current clock
+	void changeStint();
+
+	/// Add Event to box score counter of Player, if on either roster
+	void addToBox(Player player, int counter);
+
+	/// Add field goal to shot grid of Player, if on either roster
+	void addShot(Player player, int actionType, int points);
+
+	/// Count Event in box score, rebounds split by shooter as handleRebound
+	void countBoxScore(Event ev, Event lastEv);
+
+	/// Advance game clock to Event, crediting court Players with time played
+	void advanceClock(Event ev);
+
+	/// Tenths of game clock since the last possession ended
+	int possessionDuration();
+
+	/// Set cube cells of the possession starting now
+	void updateCubeCells();
+
 	/// Place period starting Players into Game
 	void updateStarters();
 
 	/// Simulate Events in Game
 	void simulateGame();
 
+	/// Reset simulation state and clock to the first Event
+	void startSimulation();
+
+	/// Simulate Events from index first to the end, taking snapshots
+	void simulateFrom(int first);
+
+	/// Simulate the next Event, taking a snapshot when due
+	void simulateNext();
+
+	/// Close the last stint once every Event is simulated
+	void finishSimulation();
+
+	/// Checks if the Event at index i has every later Event it looks at
+	// - A handler may look ahead to the next Event, through a block of
+	//   substitutions, or to the Event resolving an unknown rebound, but
+	//   never past the end of the period. A complete Game has them all.
+	bool canSimulate(int i, bool complete);
+
+	/// Simulate every Event whose lookahead is known, return Events simulated
+	int advance(bool complete);
+
+	/// Insert an Event that arrived after later ones were added
+	// - Rewinds to the snapshot at the start of its period if simulation has
+	//   passed it. Analytics tables keep the rewound Events' counts, so live
+	//   mode is not run with outputs that need them.
+	// - Returns false, and reports it, if no snapshot precedes the Event's
+	//   period, Team state then no longer matches the Events
+	bool insertLateEvent(Event ev);
+
+	/// Number of Events simulated so far
+	int getSimulated();
+
+	/// Simulate the Event at index i
+	void simulateEvent(int i);
+
+	/// Save state before Event at index i
+	GameSnapshot takeSnapshot(int i);
+
+	/// Continue from a saved state, from its Event index
+	void restoreSnapshot(GameSnapshot snapshot);
+
+	/// State just after every Event at or before PC Time of period
+	// - Restores the last snapshot before that point and replays only the
+	//   Events after it. Returns false if the Game was never simulated.
+	bool seek(int period, int pcTime, GameState *state);
+
+	/// Apply corrections, re-simulating from the first period they touch
+	// - Restores the snapshot at that period's start, replays the corrected
+	//   Events after it, and returns the changed Player counters as deltas.
+	//   Analytics tables still describe the Events first simulated.
+	// - Returns the first period corrections touch, 0 if the Game was never
+	//   simulated or a corrected Event number is missing
+	int amendEvents(std::vector<EventCorrection> corrections,
+		std::vector<CounterDelta> *deltas);
+
 	/// Print Player Data for Off and Def Rtg
 	void printRatings();
 
@@ -122,11 +308,55 @@ private:
 
 	int period;	// Current period of Game
 
+	int clockPeriod;	// Period of Event being simulated
+	int clockTime;		// PC Time of Event being simulated
+
+	int possessionStart;	// PC Time the current possession started
+
+	bool waitToSub;			// Subs wait in buffer for final FT
+	bool waitForRebound;	// Subs wait in buffer for rebound of missed FT
+
+	int simulated;	// Events simulated, the next one to simulate
+
+	bool tables;	// Analytics tables are filled while simulating
+
+	std::vector<GameSnapshot> snapshots;	// In Event order
+
 	std::vector<Player> subBufferOut;	// Holds subs to leave Game after FTs
 	std::vector<Player> subBufferIn;	// Holds subs to enter Game after FTs
 
 	Event lastPossession;		// Last Event that ended possession
 	Team lastPossessionTeam;	// Last Team to have an offensive possession
+
+	LineupTable homeLineups;	// Home lineup totals by court lineup key
+	LineupTable awayLineups;	// Away lineup totals by court lineup key
+
+	OnOffTable homeOnOff;		// Home totals split by Player on/off court
+	OnOffTable awayOnOff;		// Away totals split by Player on/off court
+
+	PairTable homePairs;		// Home totals for every pair of teammates
+	PairTable awayPairs;		// Away totals for every pair of teammates
+
+	MatchupTable matchups;		// Totals for every home and away Player pair
+
+	CubeTable homeCube;			// Home totals by slot and cube cell
+	CubeTable awayCube;			// Away totals by slot and cube cell
+
+	int homeCell;	// Cube cell of current possession for home
+	int awayCell;	// Cube cell of current possession for away
+
+	BoxScoreTable homeBox;		// Home box score counters by slot
+	BoxScoreTable awayBox;		// Away box score counters by slot
+
+	ShotTable homeShots;		// Home field goals by slot and action type
+	ShotTable awayShots;		// Away field goals by slot and action type
+
+	PaceTable homePace;			// Home court time and possession durations
+	PaceTable awayPace;			// Away court time and possession durations
+
+	StintLog stints;			// Stretches with unchanged courts
+
+	PossessionLog possessions;	// Every possession, for resampling
 };
 
 #endif // GAME_H_
@@ -0,0 +1,363 @@
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#include "leaders.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+
+// Percentile cutoffs written after the leaders
+static const int CUTOFF_PERCENTILES[] = { 10, 25, 50, 75, 90, 99 };
+
+// TopK Constructor
+
+TopK::TopK(int size, bool low) {
+	k = size;
+	lowest = low;
+}
+
+// Top-K Functions
+
+bool TopK::better(LeaderEntry a, LeaderEntry b) {
+
+	if (a.rating != b.rating) {
+		return lowest ? a.rating < b.rating : a.rating > b.rating;
+	}
+	if (a.possessions != b.possessions) return a.possessions > b.possessions;
+	if (a.gameID != b.gameID) return a.gameID < b.gameID;
+
+	return a.playerID < b.playerID;
+}
+
+void TopK::add(LeaderEntry entry) {
+
+	auto worstFirst = [this](LeaderEntry a, LeaderEntry b) {
+		return better(a, b);
+	};
+
+	if (heap.size() < k) {
+		heap.push_back(entry);
+		std::push_heap(heap.begin(), heap.end(), worstFirst);
+	}
+	else if (k > 0 && better(entry, heap.front())) {
+		std::pop_heap(heap.begin(), heap.end(), worstFirst);
+		heap.back() = entry;
+		std::push_heap(heap.begin(), heap.end(), worstFirst);
+	}
+}
+
+void TopK::merge(TopK other) {
+	for (LeaderEntry entry : other.heap) add(entry);
+}
+
+void TopK::clear() {
+	heap.clear();
+}
+
+std::vector<LeaderEntry> TopK::sorted() {
+
+	std::vector<LeaderEntry> entries = heap;
+
+	std::sort(entries.begin(), entries.end(),
+		[this](LeaderEntry a, LeaderEntry b) { return better(a, b); });
+
+	return entries;
+}
+
+// TDigest Constructor
+
+TDigest::TDigest() {
+	count = 0;
+
+	min = 0.0;
+	max = 0.0;
+}
+
+// Digest Functions
+
+/* Arcsine scale, centroids span at most one unit of it */
+static double digestScale(double q) {
+	return TDIGEST_COMPRESSION / (2.0 * PI) * std::asin(2.0 * q - 1.0);
+}
+
+void TDigest::add(double value) {
+
+	if (count == 0 || value < min) min = value;
+	if (count == 0 || value > max) max = value;
+
+	count++;
+
+	Centroid point = { value, 1.0 };
+
+	buffer.push_back(point);
+
+	if (buffer.size() >= TDIGEST_BUFFER) compress();
+}
+
+void TDigest::merge(TDigest other) {
+
+	if (other.count == 0) return;
+
+	if (count == 0 || other.min < min) min = other.min;
+	if (count == 0 || other.max > max) max = other.max;
+
+	count += other.count;
+
+	buffer.insert(buffer.end(), other.centroids.begin(),
+		other.centroids.end());
+	buffer.insert(buffer.end(), other.buffer.begin(), other.buffer.end());
+
+	// Merging many small digests, so compress like add does
+	if (buffer.size() >= TDIGEST_BUFFER) compress();
+}
+
+void TDigest::compress() {
+
+	if (buffer.empty()) return;
+
+	std::vector<Centroid> all = centroids;
+
+	all.insert(all.end(), buffer.begin(), buffer.end());
+	buffer.clear();
+
+	std::sort(all.begin(), all.end(),
+		[](Centroid a, Centroid b) { return a.mean < b.mean; });
+
+	double total = 0.0;
+
+	for (Centroid c : all) total += c.weight;
+
+	centroids.clear();
+
+	Centroid current = all[0];
+
+	double before = 0.0;	// Weight of finished centroids
+	double kLeft = digestScale(0.0);
+
+	for (int i = 1; i < all.size(); i++) {
+
+		double qRight = (before + current.weight + all[i].weight) / total;
+
+		if (digestScale(std::min(qRight, 1.0)) - kLeft <= 1.0) {
+
+			double weight = current.weight + all[i].weight;
+
+			current.mean += (all[i].mean - current.mean) * all[i].weight /
+				weight;
+			current.weight = weight;
+		}
+		else {
+			centroids.push_back(current);
+
+			before += current.weight;
+			kLeft = digestScale(before / total);
+
+			current = all[i];
+		}
+	}
+
+	centroids.push_back(current);
+}
+
+void TDigest::clear() {
+	centroids.clear();
+	buffer.clear();
+
+	count = 0;
+
+	min = 0.0;
+	max = 0.0;
+}
+
+double TDigest::quantile(double q) {
+
+	compress();
+
+	if (centroids.empty()) return 0.0;
+	if (centroids.size() == 1) return centroids[0].mean;
+
+	double target = q * count;
+
+	// Interpolate between centroid centers, and the extremes at both ends
+	double center = centroids[0].weight / 2.0;
+
+	if (target < center) {
+		return min + (centroids[0].mean - min) * target / center;
+	}
+
+	for (int i = 0; i + 1 < centroids.size(); i++) {
+
+		double next = center + (centroids[i].weight +
+			centroids[i + 1].weight) / 2.0;
+
+		if (target < next) {
+			return centroids[i].mean + (centroids[i + 1].mean -
+				centroids[i].mean) * (target - center) / (next - center);
+		}
+
+		center = next;
+	}
+
+	double tail = count - center;
+
+	if (tail <= 0.0) return max;
+
+	return centroids.back().mean + (max - centroids.back().mean) *
+		std::min(1.0, (target - center) / tail);
+}
+
+double TDigest::cdf(double value) {
+
+	compress();
+
+	if (centroids.empty()) return 0.0;
+	if (value < min) return 0.0;
+	if (value >= max) return 1.0;
+
+	double center = centroids[0].weight / 2.0;
+
+	if (value < centroids[0].mean) {
+		if (centroids[0].mean == min) return center / count;
+
+		return (value - min) / (centroids[0].mean - min) * center / count;
+	}
+
+	for (int i = 0; i + 1 < centroids.size(); i++) {
+
+		double next = center + (centroids[i].weight +
+			centroids[i + 1].weight) / 2.0;
+
+		if (value < centroids[i + 1].mean) {
+			double span = centroids[i + 1].mean - centroids[i].mean;
+			double rank = center;
+
+			if (span > 0.0) {
+				rank += (next - center) * (value - centroids[i].mean) / span;
+			}
+
+			return rank / count;
+		}
+
+		center = next;
+	}
+
+	double span = max - centroids.back().mean;
+	double rank = center;
+
+	if (span > 0.0) {
+		rank += (count - center) * (value - centroids.back().mean) / span;
+	}
+
+	return rank / count;
+}
+
+int64_t TDigest::getCount() {
+	return count;
+}
+
+// Leaderboard Constructor
+
+Leaderboard::Leaderboard() {
+	minPossessions = LEADERS_MIN_POSSESSIONS;
+
+	offLeaders = TopK(LEADERS_TOP_K, false);
+	defLeaders = TopK(LEADERS_TOP_K, true);
+}
+
+Leaderboard::Leaderboard(int topK, int minPoss) {
+	minPossessions = minPoss;
+
+	offLeaders = TopK(topK, false);
+	defLeaders = TopK(topK, true);
+}
+
+// Leaderboard Functions
+
+void Leaderboard::addTeam(std::string gameID, Team team) {
+
+	for (Player player : team.getRoster()) {
+
+		LeaderEntry entry;
+
+		entry.gameID = gameID;
+		entry.playerID = player.getPlayerID();
+
+		if (player.getOffPossessions() >= minPossessions) {
+			entry.possessions = player.getOffPossessions();
+			entry.rating = perHundred(player.getPointsFor(), entry.possessions);
+
+			offLeaders.add(entry);
+			offRatings.add(entry.rating);
+		}
+
+		if (player.getDefPossessions() >= minPossessions) {
+			entry.possessions = player.getDefPossessions();
+			entry.rating = perHundred(player.getPointsAgainst(),
+				entry.possessions);
+
+			defLeaders.add(entry);
+			defRatings.add(entry.rating);
+		}
+	}
+}
+
+void Leaderboard::addGame(Game *game) {
+	addTeam(game->getGameID(), game->getHomeTeam());
+	addTeam(game->getGameID(), game->getAwayTeam());
+}
+
+void Leaderboard::merge(Leaderboard other) {
+	offLeaders.merge(other.offLeaders);
+	defLeaders.merge(other.defLeaders);
+
+	offRatings.merge(other.offRatings);
+	defRatings.merge(other.defRatings);
+}
+
+void Leaderboard::clear() {
+	offLeaders.clear();
+	defLeaders.clear();
+
+	offRatings.clear();
+	defRatings.clear();
+}
+
+/* Write leader lines of one board, percentile is the share rated worse */
+static void writeBoard(std::string board, TopK *leaders, TDigest *ratings,
+	bool lowest, std::ostream *leaderStream) {
+
+	std::vector<LeaderEntry> entries = leaders->sorted();
+
+	for (int i = 0; i < entries.size(); i++) {
+
+		double below = ratings->cdf(entries[i].rating);
+		double percentile = 100.0 * (lowest ? 1.0 - below : below);
+
+		*leaderStream << std::fixed << std::setprecision(1) << "\"" << board
+			<< "\"," << (i + 1) << ",\"" << entries[i].gameID << "\",\""
+			<< entries[i].playerID << "\"," << entries[i].rating << ","
+			<< entries[i].possessions << "," << percentile << std::endl;
+	}
+
+	for (int percentile : CUTOFF_PERCENTILES) {
+
+		double q = percentile / 100.0;
+
+		if (lowest) q = 1.0 - q;
+
+		*leaderStream << std::fixed << std::setprecision(1) << "\"" << board
+			<< "\",\"P" << percentile << "\",\"\",\"\"," << ratings->quantile(q)
+			<< ",," << (double)percentile << std::endl;
+	}
+}
+
+void Leaderboard::write(std::ostream *leaderStream) {
+
+	*leaderStream << "\"Board\",\"Rank\",\"Game_id\",\"Person_id\",\"Rating\","
+		<< "\"Possessions\",\"Percentile\"" << std::endl;
+
+	writeBoard("OffRtg", &offLeaders, &offRatings, false, leaderStream);
+	writeBoard("DefRtg", &defLeaders, &defRatings, true, leaderStream);
+}
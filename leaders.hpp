@@ -0,0 +1,159 @@
+/* League Leaders Header */
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+// Leaderboards rank single-game OffRtg (highest first) and DefRtg (lowest
+// first) of Players with enough possessions in that Game. Each board keeps
+// a bounded top-K heap and a t-digest of every qualifying rating, so the
+// league percentile of any rating is known without sorting all of them.
+// Leaders merge into the same result in any order, but t-digest
+// percentiles are estimates that vary slightly with merge order. Each worker
+// fills one board over its contiguous range of Games, and boards are merged
+// in worker order, so a run is repeatable for a given number of workers.
+
+#ifndef LEADERS_H_
+#define LEADERS_H_
+
+#include "game.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+// Leaderboard Values
+#define LEADERS_TOP_K			25
+#define LEADERS_MIN_POSSESSIONS	20	// Per Game, on the rated side of the ball
+
+// T-Digest Values
+#define TDIGEST_COMPRESSION	100.0
+#define TDIGEST_BUFFER		500	// Points added before compressing
+#define PI					3.14159265358979323846
+
+/* One Player's rating in one Game */
+struct LeaderEntry {
+	double rating;
+	int possessions;
+
+	std::string gameID;
+	std::string playerID;
+};
+
+/* Best k entries seen, highest rating first unless lowest is set */
+class TopK {
+
+public:
+
+	TopK() { k = 0; lowest = false; }; // Default
+
+	TopK(int k, bool lowest);
+
+	/// Top-K Functions
+
+	/// Keep entry if it is among the best k
+	void add(LeaderEntry entry);
+
+	/// Keep the best k of both
+	void merge(TopK other);
+
+	/// Drop every entry, keeping k
+	void clear();
+
+	/// Kept entries, best first
+	std::vector<LeaderEntry> sorted();
+
+	/// Checks if entry a ranks ahead of entry b, ties broken by IDs
+	bool better(LeaderEntry a, LeaderEntry b);
+
+private:
+
+	int k;
+	bool lowest;
+
+	std::vector<LeaderEntry> heap;	// Worst kept entry at the front
+};
+
+/* Centroid of a t-digest */
+struct Centroid {
+	double mean;
+	double weight;
+};
+
+/* Mergeable quantile sketch (merging t-digest, arcsine scale) */
+class TDigest {
+
+public:
+
+	TDigest();
+
+	/// Digest Functions
+
+	void add(double value);
+
+	/// Add every point of other
+	void merge(TDigest other);
+
+	void clear();
+
+	/// Estimated value at quantile q in [0, 1]
+	double quantile(double q);
+
+	/// Estimated fraction of points at or below value
+	double cdf(double value);
+
+	int64_t getCount();
+
+private:
+
+	/// Fold buffered points into centroids
+	void compress();
+
+	std::vector<Centroid> centroids;	// Sorted by mean after compress
+	std::vector<Centroid> buffer;
+
+	int64_t count;
+
+	double min;
+	double max;
+};
+
+/* Single-game OffRtg and DefRtg leaders with league percentiles */
+class Leaderboard {
+
+public:
+
+	/// Board with LEADERS_TOP_K leaders and LEADERS_MIN_POSSESSIONS
+	Leaderboard();
+
+	Leaderboard(int topK, int minPossessions);
+
+	/// Leaderboard Functions
+
+	/// Add every qualifying Player rating of a finished Game
+	void addGame(Game *game);
+
+	/// Add every rating of other board
+	void merge(Leaderboard other);
+
+	/// Drop every rating, keeping board settings
+	void clear();
+
+	/// Write leaders with percentiles, then percentile cutoffs
+	void write(std::ostream *leaderStream);
+
+private:
+
+	/// Add Team roster ratings
+	void addTeam(std::string gameID, Team team);
+
+	int minPossessions;
+
+	TopK offLeaders;
+	TopK defLeaders;
+
+	TDigest offRatings;
+	TDigest defRatings;
+};
+
+#endif // LEADERS_H_
@@ -0,0 +1,200 @@
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#include "lineup.hpp"
+#include "game.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <string>
+
+
+/* Mix key bits so nearby slot tuples spread over the table */
+static uint64_t hashLineup(uint64_t key) {
+	key ^= key >> 33;
+	key *= 0xff51afd7ed558ccdULL;
+	key ^= key >> 33;
+	key *= 0xc4ceb9fe1a85ec53ULL;
+	key ^= key >> 33;
+
+	return key;
+}
+
+// Lineup Table Constructor
+
+LineupTable::LineupTable() {
+
+	LineupEntry empty = { EMPTY_LINEUP, { 0, 0, 0, 0 } };
+
+	entries.assign(LINEUP_TABLE_SIZE, empty);
+	count = 0;
+}
+
+// Lineup Functions
+
+LineupTotals *LineupTable::find(uint64_t key) {
+
+	uint64_t mask = entries.size() - 1;
+	uint64_t i = hashLineup(key) & mask;
+
+	while (entries[i].key != EMPTY_LINEUP) {
+		if (entries[i].key == key) return &entries[i].totals;
+
+		i = (i + 1) & mask;
+	}
+
+	if (2 * (count + 1) > entries.size()) {
+		grow();
+		return find(key);
+	}
+
+	entries[i].key = key;
+	count++;
+
+	return &entries[i].totals;
+}
+
+void LineupTable::grow() {
+
+	std::vector<LineupEntry> old = entries;
+
+	LineupEntry empty = { EMPTY_LINEUP, { 0, 0, 0, 0 } };
+
+	entries.assign(old.size() * 2, empty);
+	count = 0;
+
+	for (LineupEntry entry : old) {
+		if (entry.key != EMPTY_LINEUP) *find(entry.key) = entry.totals;
+	}
+}
+
+void LineupTable::offPossession(uint64_t key) {
+	if (key != EMPTY_LINEUP) find(key)->offPossessions++;
+}
+
+void LineupTable::defPossession(uint64_t key) {
+	if (key != EMPTY_LINEUP) find(key)->defPossessions++;
+}
+
+void LineupTable::score(uint64_t key, int points) {
+	if (key != EMPTY_LINEUP) find(key)->pointsFor += points;
+}
+
+void LineupTable::scoredOn(uint64_t key, int points) {
+	if (key != EMPTY_LINEUP) find(key)->pointsAgainst += points;
+}
+
+std::vector<LineupEntry> LineupTable::getLineups() const {
+
+	std::vector<LineupEntry> used;
+
+	for (LineupEntry entry : entries) {
+		if (entry.key != EMPTY_LINEUP) used.push_back(entry);
+	}
+
+	return used;
+}
+
+int LineupTable::size() {
+	return count;
+}
+
+std::vector<int> lineupSlots(uint64_t key) {
+
+	std::vector<int> slots;
+
+	while (key != EMPTY_LINEUP) {
+		slots.push_back((int)(key & 0xff) - 1);
+		key >>= 8;
+	}
+
+	std::reverse(slots.begin(), slots.end());
+
+	return slots;
+}
+
+// Season Lineup Output
+
+/* Lineup totals summed over Games */
+struct SeasonLineup {
+	std::string teamID;
+	std::string players;	// Sorted Player IDs, space separated
+
+	int games;
+	LineupTotals totals;
+};
+
+/* Add one Team's lineups from a Game to season lineups */
+static void addLineups(std::map<std::string, SeasonLineup> *season,
+	Team team, const LineupTable &table) {
+
+	std::vector<std::string> slotIDs(team.getTeamSize());
+
+	for (Player player : team.getRoster()) {
+		slotIDs[player.getSlot()] = player.getPlayerID();
+	}
+
+	for (LineupEntry entry : table.getLineups()) {
+
+		std::vector<std::string> ids;
+
+		for (int slot : lineupSlots(entry.key)) ids.push_back(slotIDs[slot]);
+
+		std::sort(ids.begin(), ids.end());
+
+		std::string players;
+
+		for (std::string id : ids) {
+			if (players != "") players += " ";
+			players += id;
+		}
+
+		std::string seasonKey = team.getTeamID() + " " + players;
+
+		auto found = season->find(seasonKey);
+
+		if (found == season->end()) {
+			SeasonLineup lineup = { team.getTeamID(), players, 0,
+				{ 0, 0, 0, 0 } };
+
+			found = season->insert(std::make_pair(seasonKey, lineup)).first;
+		}
+
+		found->second.games++;
+		found->second.totals.offPossessions += entry.totals.offPossessions;
+		found->second.totals.defPossessions += entry.totals.defPossessions;
+		found->second.totals.pointsFor += entry.totals.pointsFor;
+		found->second.totals.pointsAgainst += entry.totals.pointsAgainst;
+	}
+}
+
+void writeLineupFile(std::vector<Game> *games, std::ostream *lineupStream) {
+
+	std::map<std::string, SeasonLineup> season;
+
+	for (Game &game : *games) {
+		addLineups(&season, game.getHomeTeam(), game.getHomeLineups());
+		addLineups(&season, game.getAwayTeam(), game.getAwayLineups());
+	}
+
+	*lineupStream << "\"Team_id\",\"Lineup\",\"Games\",\"OffPoss\","
+		<< "\"DefPoss\",\"PointsFor\",\"PointsAgainst\",\"OffRtg\","
+		<< "\"DefRtg\",\"NetRtg\"" << std::endl;
+
+	for (auto &entry : season) {
+
+		LineupTotals totals = entry.second.totals;
+
+		double oRating = perHundred(totals.pointsFor, totals.offPossessions);
+		double dRating = perHundred(totals.pointsAgainst,
+			totals.defPossessions);
+
+		*lineupStream << std::fixed << std::setprecision(1) << "\""
+			<< entry.second.teamID << "\",\"" << entry.second.players << "\","
+			<< entry.second.games << "," << totals.offPossessions << ","
+			<< totals.defPossessions << "," << totals.pointsFor << ","
+			<< totals.pointsAgainst << "," << oRating << "," << dRating
+			<< "," << (oRating - dRating) << std::endl;
+	}
+}
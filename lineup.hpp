@@ -0,0 +1,71 @@
+/* Lineup Ratings Header */
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#ifndef LINEUP_H_
+#define LINEUP_H_
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+
+// Lineup Table Values
+#define LINEUP_TABLE_SIZE	64	// Initial slots, always a power of two
+#define EMPTY_LINEUP		0	// Key of an unused slot or empty court
+
+class Game;
+
+/* Possessions and points while a lineup was on court */
+struct LineupTotals {
+	int offPossessions;
+	int defPossessions;
+	int pointsFor;
+	int pointsAgainst;
+};
+
+/* Lineup key (from Team::getLineupKey) with its totals */
+struct LineupEntry {
+	uint64_t key;
+	LineupTotals totals;
+};
+
+/* Open addressing table of lineup totals for one Team in one Game */
+// - Linear probing, resized at half full so probes stay short
+class LineupTable {
+
+public:
+
+	LineupTable();
+
+	/// Lineup Functions
+
+	void offPossession(uint64_t key);
+	void defPossession(uint64_t key);
+
+	void score(uint64_t key, int points);
+	void scoredOn(uint64_t key, int points);
+
+	/// Return every used entry
+	std::vector<LineupEntry> getLineups() const;
+
+	int size();
+
+private:
+
+	/// Find totals of key, adding empty totals if new
+	LineupTotals *find(uint64_t key);
+
+	void grow();
+
+	std::vector<LineupEntry> entries;	// Slots, key EMPTY_LINEUP if unused
+	int count;							// Used slots
+};
+
+/// Decode lineup key into roster slots, in ascending order
+std::vector<int> lineupSlots(uint64_t key);
+
+/// Write season lineup ratings, summed over Games for each Team lineup
+void writeLineupFile(std::vector<Game> *games, std::ostream *lineupStream);
+
+#endif // LINEUP_H_
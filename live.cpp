@@ -0,0 +1,318 @@
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#include "live.hpp"
+#include "engine.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <sstream>
+#include <thread>
+
+
+static volatile sig_atomic_t liveInterrupted = 0;
+
+static void interruptLive(int) {
+	liveInterrupted = 1;
+}
+
+/* Checks if Event a is on an earlier game clock than Event b */
+static bool clockBefore(Event a, Event b) {
+	return a.getPeriod() < b.getPeriod() ||
+		(a.getPeriod() == b.getPeriod() && a.getPCTime() > b.getPCTime());
+}
+
+/* Checks if Player counters differ from the last written ones */
+static bool countersChanged(Player player, PlayerState state) {
+	return player.getPointsFor() != state.pointsFor ||
+		player.getPointsAgainst() != state.pointsAgainst ||
+		player.getOffPossessions() != state.offPossessions ||
+		player.getDefPossessions() != state.defPossessions;
+}
+
+// FileTail Constructor
+
+FileTail::FileTail(std::istream *s) {
+	stream = s;
+}
+
+bool FileTail::nextLine(std::string *line) {
+
+	std::string text;
+
+	if (!getline(*stream, text)) {
+		stream->clear();
+		return false;
+	}
+
+	// End of data before the newline, rest of the line is still coming
+	if (stream->eof()) {
+		partial += text;
+		stream->clear();
+		return false;
+	}
+
+	*line = partial + text;
+	partial.clear();
+
+	return true;
+}
+
+// LiveFeed Constructor
+
+LiveFeed::LiveFeed(std::ostream *u) {
+	updateStream = u;
+}
+
+// Feed Functions
+
+void LiveFeed::addGameLine(std::string line) {
+
+	if (!isValidLine(line)) return;
+
+	std::string gameID = cleanString(line.substr(0, line.find('\t')));
+
+	if (gameLines.find(gameID) == gameLines.end()) {
+		gameOrder.push_back(gameID);
+	}
+
+	gameLines[gameID] += line + "\n";
+}
+
+LiveGame *LiveFeed::startGame(std::string gameID) {
+
+	auto found = gameLines.find(gameID);
+
+	if (found == gameLines.end()) return NULL;
+
+	std::istringstream gameStream(found->second);
+
+	std::vector<Game> made = makeRosters(&gameStream);
+
+	LiveGame live;
+
+	live.game = made[0];
+	live.started = false;
+	live.complete = false;
+	live.dropped = false;
+
+	games[gameID] = live;
+
+	return &games[gameID];
+}
+
+void LiveFeed::addPlayLine(std::string line) {
+
+	if (!isValidLine(line)) return;
+
+	auto arrival = std::chrono::steady_clock::now();
+
+	std::string gameID = cleanString(line.substr(0, line.find('\t')));
+
+	LiveGame *live;
+
+	auto found = games.find(gameID);
+
+	if (found != games.end()) live = &found->second;
+	else live = startGame(gameID);
+
+	if (live == NULL) {
+		std::cerr << "No Game File lines for game " << gameID << std::endl;
+		return;
+	}
+
+	if (live->complete) return;
+
+	Event ev = makeEvent(line);
+
+	bool complete = ev.isGameCompleted();
+
+	if (!live->held.empty() && clockBefore(ev, live->held[0])) {
+
+		// Counters published from here on would be wrong, stop the Game
+		if (!live->game.insertLateEvent(ev)) {
+			std::cerr << "Dropping live game " << gameID << std::endl;
+
+			live->complete = true;
+			live->dropped = true;
+			return;
+		}
+	}
+	else {
+		// Held Events can no longer be passed, their order is final
+		if (!live->held.empty() && clockBefore(live->held[0], ev)) {
+
+			std::sort(live->held.begin(), live->held.end());
+
+			for (Event heldEvent : live->held) live->game.addEvent(heldEvent);
+
+			live->held.clear();
+		}
+
+		live->held.push_back(ev);
+	}
+
+	if (complete) {
+		std::sort(live->held.begin(), live->held.end());
+
+		for (Event heldEvent : live->held) live->game.addEvent(heldEvent);
+
+		live->held.clear();
+		live->complete = true;
+	}
+
+	if (!live->started) {
+
+		if (live->game.getGameEvents().empty()) return;
+
+		live->game.startSimulation();
+		live->started = true;
+	}
+
+	if (live->game.advance(complete) == 0 && !complete) return;
+
+	if (complete) {
+		live->game.finishSimulation();
+		live->game.updateRosters();
+	}
+
+	if (publish(live) > 0) {
+		std::chrono::duration<double, std::micro> latency =
+			std::chrono::steady_clock::now() - arrival;
+
+		latencies.push_back(latency.count());
+	}
+}
+
+int LiveFeed::publish(LiveGame *live) {
+
+	std::vector<Player> players;
+
+	for (Team team : { live->game.getHomeTeam(), live->game.getAwayTeam() }) {
+
+		std::vector<Player> court = team.getCourt();
+		std::vector<Player> bench = team.getBench();
+
+		players.insert(players.end(), court.begin(), court.end());
+		players.insert(players.end(), bench.begin(), bench.end());
+	}
+
+	int written = 0;
+
+	for (Player player : players) {
+
+		PlayerState state = PlayerState();
+
+		auto found = live->published.find(player.getPlayerID());
+
+		if (found != live->published.end()) state = found->second;
+
+		if (!countersChanged(player, state)) continue;
+
+		state.pointsFor = player.getPointsFor();
+		state.pointsAgainst = player.getPointsAgainst();
+		state.offPossessions = player.getOffPossessions();
+		state.defPossessions = player.getDefPossessions();
+
+		live->published[player.getPlayerID()] = state;
+
+		writePlayerData(player, live->game.getGameID(), updateStream);
+
+		written++;
+	}
+
+	return written;
+}
+
+bool LiveFeed::isDone() {
+
+	if (gameOrder.empty()) return false;
+
+	for (std::string gameID : gameOrder) {
+
+		auto found = games.find(gameID);
+
+		if (found == games.end() || !found->second.complete) return false;
+	}
+
+	return true;
+}
+
+std::vector<Game> LiveFeed::getGames() {
+
+	std::vector<Game> completed;
+
+	for (std::string gameID : gameOrder) {
+
+		auto found = games.find(gameID);
+
+		if (found != games.end() && found->second.complete &&
+			!found->second.dropped) {
+			completed.push_back(found->second.game);
+		}
+	}
+
+	return completed;
+}
+
+void LiveFeed::printLatency() {
+
+	if (latencies.empty()) return;
+
+	std::vector<double> sorted = latencies;
+
+	std::sort(sorted.begin(), sorted.end());
+
+	std::cout << "Published " << sorted.size() << " updates, latency median "
+		<< sorted[sorted.size() / 2] << " us, p99 "
+		<< sorted[sorted.size() * 99 / 100] << " us, max " << sorted.back()
+		<< " us" << std::endl;
+}
+
+std::vector<Game> runLiveGames(std::istream *gameStream,
+	std::istream *playStream, std::ostream *updateStream) {
+
+	FileTail gameTail(gameStream);
+	FileTail playTail(playStream);
+
+	LiveFeed feed(updateStream);
+
+	liveInterrupted = 0;
+	signal(SIGINT, interruptLive);
+	signal(SIGTERM, interruptLive);
+
+	std::string line;
+
+	while (!liveInterrupted && !feed.isDone()) {
+
+		bool readAny = false;
+
+		// Game File lines of a Game are written before its Play lines
+		while (gameTail.nextLine(&line)) {
+			feed.addGameLine(line);
+			readAny = true;
+		}
+
+		while (!liveInterrupted && playTail.nextLine(&line)) {
+			feed.addPlayLine(line);
+			readAny = true;
+		}
+
+		if (!readAny) {
+			std::this_thread::sleep_for(
+				std::chrono::milliseconds(LIVE_POLL_INTERVAL));
+		}
+	}
+
+	feed.printLatency();
+
+	std::vector<Game> games = feed.getGames();
+
+	if (liveInterrupted) {
+		std::cout << "Interrupted with " << games.size()
+			<< " games complete" << std::endl;
+	}
+
+	return games;
+}
@@ -0,0 +1,110 @@
+/* Live Feed Header */
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+// Live mode tails Game and Play files that are still being written. Each
+// Play line is routed to its Game, which simulates every Event whose
+// lookahead is already known (Game::canSimulate) instead of waiting for
+// Game complete. Player ratings that change are written as soon as the
+// possession ending them is simulated, in Data File layout.
+//
+// Events of one Game arrive in clock order, but Events on the same clock
+// may still be reordered by the Event sort. Events on the newest clock are
+// held until a later clock arrives, so the simulated order matches a batch
+// run. An Event arriving behind the clock is inserted with
+// Game::insertLateEvent.
+
+#ifndef LIVE_H_
+#define LIVE_H_
+
+#include "game.hpp"
+#include "team.hpp"
+
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+// Live Feed Values
+#define LIVE_POLL_INTERVAL	2	// Milliseconds between reads at end of file
+
+/* Complete lines appended to a growing stream */
+class FileTail {
+
+public:
+
+	FileTail(std::istream *s);
+
+	/// Read next complete line, false if none has been written yet
+	bool nextLine(std::string *line);
+
+private:
+
+	std::istream *stream;
+
+	std::string partial;	// Start of a line still being written
+};
+
+/* Live simulation state of one Game */
+struct LiveGame {
+	Game game;
+
+	std::vector<Event> held;	// Events on the newest clock, unsorted
+
+	bool started;
+	bool complete;
+	bool dropped;	// A late Event could not be replayed, no longer written
+
+	// Counters last written for each Player ID
+	std::unordered_map<std::string, PlayerState> published;
+};
+
+/* Routes live Game and Play lines to per-game simulations */
+class LiveFeed {
+
+public:
+
+	LiveFeed(std::ostream *u);
+
+	/// Feed Functions
+
+	/// Keep Game File line until its Game's first Play line arrives
+	void addGameLine(std::string line);
+
+	/// Route Play line to its Game, simulate and publish what it settles
+	void addPlayLine(std::string line);
+
+	/// Checks if every Game of the Game File is complete
+	bool isDone();
+
+	/// Completed Games in Game File order, with updated rosters
+	// - Dropped Games are left out
+	std::vector<Game> getGames();
+
+	/// Print count and latency of published updates
+	void printLatency();
+
+private:
+
+	/// Start Game from its Game File lines
+	LiveGame *startGame(std::string gameID);
+
+	/// Write every Player whose counters changed since last written
+	int publish(LiveGame *live);
+
+	std::ostream *updateStream;
+
+	std::vector<std::string> gameOrder;	// Game IDs in Game File order
+	std::unordered_map<std::string, std::string> gameLines;
+	std::unordered_map<std::string, LiveGame> games;
+
+	std::vector<double> latencies;	// Microseconds, line read to publish
+};
+
+/// Tail Game and Play streams until every Game completes or interrupted
+// - Rating updates go to updateStream as they happen
+std::vector<Game> runLiveGames(std::istream *gameStream,
+	std::istream *playStream, std::ostream *updateStream);
+
+#endif // LIVE_H_
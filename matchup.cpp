@@ -0,0 +1,243 @@
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#include "matchup.hpp"
+#include "game.hpp"
+#include "parallel.hpp"
+#include "season.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+
+// Matchup Table Constructor
+
+MatchupTable::MatchupTable(int homeSlotCount, int awaySlotCount) {
+
+	homeSlots = std::min(homeSlotCount, COURT_MASK_SLOTS);
+	awaySlots = std::min(awaySlotCount, COURT_MASK_SLOTS);
+
+	MatchupTotals empty = { 0, 0, 0, 0 };
+
+	grid.assign(homeSlots * awaySlots, empty);
+}
+
+// Matchup Functions
+
+void MatchupTable::addMatchups(uint64_t homeMask, uint64_t awayMask,
+	int MatchupTotals::*field, int amount) {
+
+	if (homeSlots < COURT_MASK_SLOTS) {
+		homeMask &= ((uint64_t)1 << homeSlots) - 1;
+	}
+	if (awaySlots < COURT_MASK_SLOTS) {
+		awayMask &= ((uint64_t)1 << awaySlots) - 1;
+	}
+
+	// Visits only the court by court cross product, 25 cells per event
+	for (uint64_t home = homeMask; home != 0; home &= home - 1) {
+
+		MatchupTotals *row = &grid[lowestCourtSlot(home) * awaySlots];
+
+		for (uint64_t away = awayMask; away != 0; away &= away - 1) {
+			row[lowestCourtSlot(away)].*field += amount;
+		}
+	}
+}
+
+void MatchupTable::homePossession(uint64_t homeMask, uint64_t awayMask) {
+	addMatchups(homeMask, awayMask, &MatchupTotals::homePossessions, 1);
+}
+
+void MatchupTable::awayPossession(uint64_t homeMask, uint64_t awayMask) {
+	addMatchups(homeMask, awayMask, &MatchupTotals::awayPossessions, 1);
+}
+
+void MatchupTable::homeScore(uint64_t homeMask, uint64_t awayMask,
+	int points) {
+	addMatchups(homeMask, awayMask, &MatchupTotals::homePoints, points);
+}
+
+void MatchupTable::awayScore(uint64_t homeMask, uint64_t awayMask,
+	int points) {
+	addMatchups(homeMask, awayMask, &MatchupTotals::awayPoints, points);
+}
+
+// Matchup Getters
+
+int MatchupTable::getHomeSlotCount() const {
+	return homeSlots;
+}
+
+int MatchupTable::getAwaySlotCount() const {
+	return awaySlots;
+}
+
+MatchupTotals MatchupTable::getMatchup(int homeSlot, int awaySlot) const {
+	return grid[homeSlot * awaySlots + awaySlot];
+}
+
+// Season Matchup Output
+
+typedef std::unordered_map<uint64_t, MatchupEntry> MatchupMap;
+
+/* Key of Player and opponent handles */
+static uint64_t matchupKey(uint32_t player, uint32_t opponent) {
+	return ((uint64_t)player << 32) | opponent;
+}
+
+static void addEntry(MatchupMap *matchups, MatchupEntry entry) {
+
+	uint64_t key = matchupKey(entry.player, entry.opponent);
+
+	auto found = matchups->find(key);
+
+	if (found == matchups->end()) {
+		(*matchups)[key] = entry;
+		return;
+	}
+
+	found->second.offPossessions += entry.offPossessions;
+	found->second.defPossessions += entry.defPossessions;
+	found->second.pointsFor += entry.pointsFor;
+	found->second.pointsAgainst += entry.pointsAgainst;
+}
+
+/* Global handle of every roster slot of Team */
+static std::vector<int> slotHandles(Team team, PlayerIndex *index) {
+
+	std::vector<int> handles(team.getTeamSize(), NO_HANDLE);
+
+	for (Player player : team.getRoster()) {
+		handles[player.getSlot()] = index->intern(player.getPlayerID());
+	}
+
+	return handles;
+}
+
+/* Add both directions of every non-empty cell of a Game's matrix */
+static void addGame(MatchupMap *matchups, const MatchupTable &table,
+	std::vector<int> homeHandles, std::vector<int> awayHandles) {
+
+	for (int h = 0; h < table.getHomeSlotCount(); h++) {
+		for (int a = 0; a < table.getAwaySlotCount(); a++) {
+
+			MatchupTotals cell = table.getMatchup(h, a);
+
+			if (cell.homePossessions == 0 && cell.awayPossessions == 0 &&
+				cell.homePoints == 0 && cell.awayPoints == 0) {
+				continue;
+			}
+
+			MatchupEntry home = { (uint32_t)homeHandles[h],
+				(uint32_t)awayHandles[a], cell.homePossessions,
+				cell.awayPossessions, cell.homePoints, cell.awayPoints };
+
+			MatchupEntry away = { (uint32_t)awayHandles[a],
+				(uint32_t)homeHandles[h], cell.awayPossessions,
+				cell.homePossessions, cell.awayPoints, cell.homePoints };
+
+			addEntry(matchups, home);
+			addEntry(matchups, away);
+		}
+	}
+}
+
+static bool entryLess(const MatchupEntry &a, const MatchupEntry &b) {
+	return matchupKey(a.player, a.opponent) < matchupKey(b.player, b.opponent);
+}
+
+bool writeMatchupFile(std::vector<Game> *games, int threads,
+	std::ostream *matchupStream) {
+
+	// Intern serially so handles follow first appearance in Games
+	PlayerIndex index;
+
+	std::vector<std::vector<int>> homeHandles, awayHandles;
+
+	for (Game &game : *games) {
+		homeHandles.push_back(slotHandles(game.getHomeTeam(), &index));
+		awayHandles.push_back(slotHandles(game.getAwayTeam(), &index));
+	}
+
+	// Fixed width IDs are never truncated, that could merge two Players
+	for (int h = 0; h < index.size(); h++) {
+		if (index.getPlayerID(h).length() > MATCHUP_ID_LENGTH) {
+			std::cerr << "ID too long for matchup file: "
+				<< index.getPlayerID(h) << std::endl;
+			return false;
+		}
+	}
+
+	threads = rangeCount(games->size(), threads);
+
+	std::vector<MatchupMap> partials(threads);
+
+	// Entries of each partial, split by the thread owning their Player
+	std::vector<std::vector<std::vector<MatchupEntry>>> outgoing(threads,
+		std::vector<std::vector<MatchupEntry>>(threads));
+
+	parallelRanges(games->size(), threads,
+		[&](int thread, int begin, int end) {
+
+		for (int i = begin; i < end; i++) {
+			addGame(&partials[thread], (*games)[i].getMatchups(),
+				homeHandles[i], awayHandles[i]);
+		}
+
+		for (auto &entry : partials[thread]) {
+			outgoing[thread][entry.second.player % threads].push_back(
+				entry.second);
+		}
+	});
+
+	// Each thread merges only the entries of the Players it owns
+	std::vector<std::vector<MatchupEntry>> merged(threads);
+
+	parallelRanges(threads, threads, [&](int thread, int, int) {
+
+		MatchupMap bucket;
+
+		for (int t = 0; t < threads; t++) {
+			for (MatchupEntry entry : outgoing[t][thread]) {
+				addEntry(&bucket, entry);
+			}
+		}
+
+		for (auto &entry : bucket) merged[thread].push_back(entry.second);
+	});
+
+	std::vector<MatchupEntry> entries;
+
+	for (std::vector<MatchupEntry> &bucket : merged) {
+		entries.insert(entries.end(), bucket.begin(), bucket.end());
+	}
+
+	std::sort(entries.begin(), entries.end(), entryLess);
+
+	MatchupHeader header;
+
+	header.magic = MATCHUP_MAGIC;
+	header.version = MATCHUP_VERSION;
+	header.playerCount = index.size();
+	header.entryCount = entries.size();
+
+	matchupStream->write((const char *)&header, sizeof(header));
+
+	for (int h = 0; h < index.size(); h++) {
+
+		char id[MATCHUP_ID_LENGTH];
+		std::string playerID = index.getPlayerID(h);
+
+		std::memset(id, 0, MATCHUP_ID_LENGTH);
+		std::memcpy(id, playerID.data(), playerID.length());
+
+		matchupStream->write(id, MATCHUP_ID_LENGTH);
+	}
+
+	matchupStream->write((const char *)entries.data(),
+		entries.size() * sizeof(MatchupEntry));
+
+	return !matchupStream->fail();
+}
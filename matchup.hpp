@@ -0,0 +1,92 @@
+/* Matchup Matrix Header */
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#ifndef MATCHUP_H_
+#define MATCHUP_H_
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+
+// Matchup File Values
+#define MATCHUP_MAGIC		0x554d4242	// "BBMU"
+#define MATCHUP_VERSION		1
+#define MATCHUP_ID_LENGTH	40
+
+class Game;
+
+/* Possessions and points while a home and away Player shared the court */
+struct MatchupTotals {
+	int homePossessions;
+	int awayPossessions;
+	int homePoints;
+	int awayPoints;
+};
+
+/* Home slot by away slot matrix of overlap totals for one Game */
+class MatchupTable {
+
+public:
+
+	MatchupTable() { homeSlots = 0; awaySlots = 0; }; // Default
+
+	/// Construct empty matrix for home and away roster sizes
+	MatchupTable(int homeSlotCount, int awaySlotCount);
+
+	/// Matchup Functions
+
+	/// Add to every home by away pair in court masks
+	void homePossession(uint64_t homeMask, uint64_t awayMask);
+	void awayPossession(uint64_t homeMask, uint64_t awayMask);
+
+	void homeScore(uint64_t homeMask, uint64_t awayMask, int points);
+	void awayScore(uint64_t homeMask, uint64_t awayMask, int points);
+
+	/// Matchup Getters
+
+	int getHomeSlotCount() const;
+	int getAwaySlotCount() const;
+
+	MatchupTotals getMatchup(int homeSlot, int awaySlot) const;
+
+private:
+
+	/// Add to one field of every home by away pair in masks
+	void addMatchups(uint64_t homeMask, uint64_t awayMask,
+		int MatchupTotals::*field, int amount);
+
+	int homeSlots;
+	int awaySlots;
+
+	std::vector<MatchupTotals> grid;	// Row per home slot
+};
+
+/* Matchup file layout */
+// - MatchupHeader, then playerCount fixed width Player IDs, then
+//   entryCount MatchupEntry sorted by player, then opponent
+struct MatchupHeader {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t playerCount;
+	uint32_t entryCount;
+};
+
+/* Season totals of a Player (index into ID table) against one opponent */
+struct MatchupEntry {
+	uint32_t player;
+	uint32_t opponent;
+	int32_t offPossessions;		// Player's team on offense
+	int32_t defPossessions;		// Opponent's team on offense
+	int32_t pointsFor;
+	int32_t pointsAgainst;
+};
+
+/// Merge every Game's matrix into season totals and write binary file
+// - Threads each fill a hash map for a range of Games, then the key
+//   space is split across threads to merge the maps
+bool writeMatchupFile(std::vector<Game> *games, int threads,
+	std::ostream *matchupStream);
+
+#endif // MATCHUP_H_
@@ -0,0 +1,459 @@
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#include "metric.hpp"
+
+#include <cctype>
+#include <cstdlib>
+#include <iomanip>
+
+
+/* Expression text being compiled into a Metric */
+struct MetricParser {
+	std::string text;
+	int pos;
+
+	std::vector<std::string> *names;
+	Metric *metric;
+
+	int depth;	// Columns on the stack after the code so far
+	std::string error;
+};
+
+// Parsing Functions
+
+static void skipSpaces(MetricParser *parser) {
+	while (parser->pos < parser->text.length() &&
+		isspace((unsigned char)parser->text[parser->pos])) {
+		parser->pos++;
+	}
+}
+
+/* Append instruction, tracking stack depth */
+static void emit(MetricParser *parser, int op, int operand) {
+
+	MetricInstruction instruction;
+
+	instruction.op = op;
+	instruction.operand = operand;
+
+	parser->metric->code.push_back(instruction);
+
+	if (op == METRIC_CONST || op == METRIC_LOAD) parser->depth++;
+	else if (op != METRIC_NEG) parser->depth--;
+
+	if (parser->depth > parser->metric->stackDepth) {
+		parser->metric->stackDepth = parser->depth;
+	}
+}
+
+static bool isNameStart(char c) {
+	return isalpha((unsigned char)c) || c == '_';
+}
+
+static bool isNameChar(char c) {
+	return isalnum((unsigned char)c) || c == '_';
+}
+
+static bool parseSum(MetricParser *parser);
+
+/* Number, name or parenthesized sum */
+static bool parsePrimary(MetricParser *parser) {
+
+	skipSpaces(parser);
+
+	if (parser->pos >= parser->text.length()) {
+		parser->error = "expression ends early";
+		return false;
+	}
+
+	const char *start = parser->text.c_str() + parser->pos;
+	char c = *start;
+
+	if (c == '(') {
+		parser->pos++;
+
+		if (!parseSum(parser)) return false;
+
+		skipSpaces(parser);
+
+		if (parser->pos >= parser->text.length() ||
+			parser->text[parser->pos] != ')') {
+			parser->error = "missing )";
+			return false;
+		}
+
+		parser->pos++;
+		return true;
+	}
+
+	if (isdigit((unsigned char)c) || c == '.') {
+		char *end;
+		double value = strtod(start, &end);
+
+		if (end == start) {
+			parser->error = "bad number";
+			return false;
+		}
+
+		parser->pos += end - start;
+
+		parser->metric->constants.push_back(value);
+		emit(parser, METRIC_CONST, parser->metric->constants.size() - 1);
+
+		return true;
+	}
+
+	if (isNameStart(c)) {
+		int first = parser->pos;
+
+		while (parser->pos < parser->text.length() &&
+			isNameChar(parser->text[parser->pos])) {
+			parser->pos++;
+		}
+
+		std::string name = parser->text.substr(first, parser->pos - first);
+
+		for (int i = 0; i < parser->names->size(); i++) {
+			if ((*parser->names)[i] == name) {
+				emit(parser, METRIC_LOAD, i);
+				return true;
+			}
+		}
+
+		parser->error = "unknown name " + name;
+		return false;
+	}
+
+	parser->error = std::string("unexpected ") + c;
+	return false;
+}
+
+static bool parseUnary(MetricParser *parser) {
+
+	skipSpaces(parser);
+
+	if (parser->pos < parser->text.length() &&
+		parser->text[parser->pos] == '-') {
+		parser->pos++;
+
+		if (!parseUnary(parser)) return false;
+
+		emit(parser, METRIC_NEG, 0);
+		return true;
+	}
+
+	return parsePrimary(parser);
+}
+
+static bool parseProduct(MetricParser *parser) {
+
+	if (!parseUnary(parser)) return false;
+
+	while (true) {
+		skipSpaces(parser);
+
+		if (parser->pos >= parser->text.length()) return true;
+
+		char c = parser->text[parser->pos];
+
+		if (c != '*' && c != '/') return true;
+
+		parser->pos++;
+
+		if (!parseUnary(parser)) return false;
+
+		emit(parser, c == '*' ? METRIC_MUL : METRIC_DIV, 0);
+	}
+}
+
+static bool parseSum(MetricParser *parser) {
+
+	if (!parseProduct(parser)) return false;
+
+	while (true) {
+		skipSpaces(parser);
+
+		if (parser->pos >= parser->text.length()) return true;
+
+		char c = parser->text[parser->pos];
+
+		if (c != '+' && c != '-') return true;
+
+		parser->pos++;
+
+		if (!parseProduct(parser)) return false;
+
+		emit(parser, c == '+' ? METRIC_ADD : METRIC_SUB, 0);
+	}
+}
+
+/* Text without leading and trailing spaces */
+static std::string trim(std::string text) {
+
+	std::size_t first = text.find_first_not_of(" \t\r\n");
+
+	if (first == std::string::npos) return "";
+
+	std::size_t last = text.find_last_not_of(" \t\r\n");
+
+	return text.substr(first, last - first + 1);
+}
+
+std::vector<std::string> counterNames() {
+
+	// Same order as the row gathered by addRow
+	return { "PtsFor", "PtsAgainst", "OffPoss", "DefPoss", "Minutes",
+		"Points", "FGM", "FGA", "FG3M", "FG3A", "FTM", "FTA", "OREB", "DREB",
+		"TOV", "Fouls" };
+}
+
+bool compileMetric(std::string line, std::vector<std::string> names,
+	Metric *metric, std::string *error) {
+
+	std::size_t equals = line.find('=');
+
+	if (equals == std::string::npos) {
+		*error = "expected Name = expression";
+		return false;
+	}
+
+	metric->name = trim(line.substr(0, equals));
+	metric->text = trim(line.substr(equals + 1));
+	metric->code.clear();
+	metric->constants.clear();
+	metric->stackDepth = 0;
+
+	bool validName = metric->name != "" && isNameStart(metric->name[0]);
+
+	for (char c : metric->name) validName = validName && isNameChar(c);
+
+	if (!validName) {
+		*error = "bad metric name " + metric->name;
+		return false;
+	}
+
+	for (std::string name : names) {
+		if (name == metric->name) {
+			*error = metric->name + " is already defined";
+			return false;
+		}
+	}
+
+	MetricParser parser;
+
+	parser.text = metric->text;
+	parser.pos = 0;
+	parser.names = &names;
+	parser.metric = metric;
+	parser.depth = 0;
+
+	if (!parseSum(&parser)) {
+		*error = parser.error;
+		return false;
+	}
+
+	skipSpaces(&parser);
+
+	if (parser.pos < parser.text.length()) {
+		*error = std::string("unexpected ") + parser.text[parser.pos];
+		return false;
+	}
+
+	return true;
+}
+
+bool readMetrics(std::istream *metricStream, std::vector<Metric> *metrics,
+	std::string *error) {
+
+	std::vector<std::string> names = counterNames();
+
+	std::string line;
+	int lineNumber = 0;
+
+	while (getline(*metricStream, line)) {
+
+		lineNumber++;
+
+		line = trim(line.substr(0, line.find('#')));
+
+		if (line == "") continue;
+
+		Metric metric;
+		std::string message;
+
+		if (!compileMetric(line, names, &metric, &message)) {
+			*error = "line " + std::to_string(lineNumber) + ": " + message;
+			return false;
+		}
+
+		names.push_back(metric.name);
+		metrics->push_back(metric);
+	}
+
+	return true;
+}
+
+// Metric Evaluation
+
+/* Append counters of Player as one row */
+static void addRow(MetricColumns *columns, Player player,
+	const BoxScoreTable *box, const PaceTable *pace) {
+
+	int slot = player.getSlot();
+
+	int fgm2 = box->get(slot, BOX_FGM2);
+	int fgm3 = box->get(slot, BOX_FGM3);
+	int ftm = box->get(slot, BOX_FTM);
+
+	double row[] = { (double)player.getPointsFor(),
+		(double)player.getPointsAgainst(), (double)player.getOffPossessions(),
+		(double)player.getDefPossessions(),
+		pace->getCourtTime(slot) / (double)(SECONDS * TENTHS),
+		(double)(fgm2 * TWO_POINTS + fgm3 * THREE_POINTS + ftm),
+		(double)(fgm2 + fgm3),
+		(double)(box->get(slot, BOX_FGA2) + box->get(slot, BOX_FGA3)),
+		(double)fgm3, (double)box->get(slot, BOX_FGA3), (double)ftm,
+		(double)box->get(slot, BOX_FTA), (double)box->get(slot, BOX_OREB),
+		(double)box->get(slot, BOX_DREB), (double)box->get(slot, BOX_TOV),
+		(double)box->get(slot, BOX_FOULS) };
+
+	for (int i = 0; i < columns->values.size(); i++) {
+		columns->values[i].push_back(row[i]);
+	}
+
+	columns->rows++;
+}
+
+MetricColumns gatherColumns(std::vector<Game> *games) {
+
+	MetricColumns columns;
+
+	columns.rows = 0;
+	columns.names = counterNames();
+	columns.values.resize(columns.names.size());
+
+	for (Game &game : *games) {
+
+		const BoxScoreTable &homeBox = game.getHomeBox();
+		const BoxScoreTable &awayBox = game.getAwayBox();
+
+		const PaceTable &homePace = game.getHomePace();
+		const PaceTable &awayPace = game.getAwayPace();
+
+		for (Player player : game.getHomeTeam().getRoster()) {
+			addRow(&columns, player, &homeBox, &homePace);
+		}
+		for (Player player : game.getAwayTeam().getRoster()) {
+			addRow(&columns, player, &awayBox, &awayPace);
+		}
+	}
+
+	return columns;
+}
+
+void evaluateMetric(Metric metric, MetricColumns *columns) {
+
+	int rows = columns->rows;
+
+	// Stack entries point at a column or at the buffer of their depth
+	std::vector<std::vector<double>> buffers(metric.stackDepth,
+		std::vector<double>(rows));
+	std::vector<const double *> stack(metric.stackDepth);
+
+	int top = 0;
+
+	for (MetricInstruction instruction : metric.code) {
+
+		if (instruction.op == METRIC_CONST) {
+			double value = metric.constants[instruction.operand];
+			double *out = buffers[top].data();
+
+			for (int r = 0; r < rows; r++) out[r] = value;
+
+			stack[top++] = out;
+		}
+		else if (instruction.op == METRIC_LOAD) {
+			stack[top++] = columns->values[instruction.operand].data();
+		}
+		else if (instruction.op == METRIC_NEG) {
+			const double *a = stack[top - 1];
+			double *out = buffers[top - 1].data();
+
+			for (int r = 0; r < rows; r++) out[r] = -a[r];
+
+			stack[top - 1] = out;
+		}
+		else {
+			const double *a = stack[top - 2];
+			const double *b = stack[top - 1];
+			double *out = buffers[top - 2].data();
+
+			switch (instruction.op) {
+			case METRIC_ADD:
+				for (int r = 0; r < rows; r++) out[r] = a[r] + b[r];
+				break;
+			case METRIC_SUB:
+				for (int r = 0; r < rows; r++) out[r] = a[r] - b[r];
+				break;
+			case METRIC_MUL:
+				for (int r = 0; r < rows; r++) out[r] = a[r] * b[r];
+				break;
+			case METRIC_DIV:
+				for (int r = 0; r < rows; r++) {
+					out[r] = (b[r] != 0.0) ? a[r] / b[r] : 0.0;
+				}
+				break;
+			}
+
+			stack[top - 2] = out;
+			top--;
+		}
+	}
+
+	columns->names.push_back(metric.name);
+	columns->values.push_back(std::vector<double>(stack[0], stack[0] + rows));
+}
+
+void writeMetricFile(std::vector<Game> *games, std::vector<Metric> metrics,
+	std::ostream *dataStream) {
+
+	MetricColumns columns = gatherColumns(games);
+
+	int first = columns.values.size();
+
+	for (Metric metric : metrics) evaluateMetric(metric, &columns);
+
+	*dataStream << "\"Game_id\",\"Person_id\",\"OffRtg\",\"DefRtg\"";
+
+	for (Metric metric : metrics) *dataStream << ",\"" << metric.name << "\"";
+
+	*dataStream << std::endl;
+
+	int row = 0;
+
+	for (Game &game : *games) {
+
+		std::vector<Player> players = game.getHomeTeam().getRoster();
+		std::vector<Player> away = game.getAwayTeam().getRoster();
+
+		players.insert(players.end(), away.begin(), away.end());
+
+		for (Player player : players) {
+
+			*dataStream << std::fixed << std::setprecision(1) << "\""
+				<< game.getGameID() << "\",\"" << player.getPlayerID() << "\","
+				<< perHundred(player.getPointsFor(), player.getOffPossessions())
+				<< "," << perHundred(player.getPointsAgainst(),
+					player.getDefPossessions())
+				<< std::setprecision(METRIC_PRECISION);
+
+			for (int m = 0; m < metrics.size(); m++) {
+				*dataStream << "," << columns.values[first + m][row];
+			}
+
+			*dataStream << "\n";
+			row++;
+		}
+	}
+}
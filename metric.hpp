@@ -0,0 +1,87 @@
+/* Metric Expression Header */
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+// User metrics are read from a file, one "Name = expression" per line
+// ("#" starts a comment). Expressions use numbers, + - * /, parentheses,
+// the counters below and any metric defined on an earlier line:
+//
+//   NetRtg = 100 * (PtsFor / OffPoss - PtsAgainst / DefPoss)
+//   Per36  = 36 * Points / Minutes
+//   Blend  = 0.7 * NetRtg + 0.3 * Per36
+//
+// Division by zero gives zero, like a rating without possessions. Each
+// expression is compiled once to stack bytecode, which is run one
+// instruction at a time over whole columns of every player row.
+
+#ifndef METRIC_H_
+#define METRIC_H_
+
+#include "game.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+// Metric Bytecode Operations
+#define METRIC_CONST	0	// Push constant of operand
+#define METRIC_LOAD		1	// Push column of operand
+#define METRIC_ADD		2
+#define METRIC_SUB		3
+#define METRIC_MUL		4
+#define METRIC_DIV		5
+#define METRIC_NEG		6
+
+// Metric Output Values
+#define METRIC_PRECISION	3
+
+/* One bytecode instruction */
+struct MetricInstruction {
+	int op;
+	int operand;	// Constant or column index
+};
+
+/* Compiled metric expression */
+struct Metric {
+	std::string name;
+	std::string text;
+
+	std::vector<MetricInstruction> code;	// Postfix order
+	std::vector<double> constants;
+
+	int stackDepth;	// Columns needed to evaluate
+};
+
+/* Per-player counters of every row, one contiguous column per name */
+// - Rows follow Data File order, metrics are appended as they evaluate
+struct MetricColumns {
+	int rows;
+
+	std::vector<std::string> names;
+	std::vector<std::vector<double>> values;
+};
+
+/// Names of the counter columns filled by gatherColumns
+std::vector<std::string> counterNames();
+
+/// Compile "Name = expression" against known column names
+// - Returns false with a message if malformed or a name is unknown
+bool compileMetric(std::string line, std::vector<std::string> names,
+	Metric *metric, std::string *error);
+
+/// Read and compile every metric of a metrics file
+bool readMetrics(std::istream *metricStream, std::vector<Metric> *metrics,
+	std::string *error);
+
+/// Gather counter columns for every roster Player of every Game
+MetricColumns gatherColumns(std::vector<Game> *games);
+
+/// Evaluate metric over every row, appending its column
+void evaluateMetric(Metric metric, MetricColumns *columns);
+
+/// Write Data File with one extra column per metric
+void writeMetricFile(std::vector<Game> *games, std::vector<Metric> metrics,
+	std::ostream *dataStream);
+
+#endif // METRIC_H_
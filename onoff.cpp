@@ -0,0 +1,128 @@
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#include "onoff.hpp"
+#include "game.hpp"
+
+#include <iomanip>
+
+
+/* Add amount to every count whose bit is set in mask */
+// - Branch free so the loop vectorizes over all slots
+static void addMasked(int *counts, uint64_t mask, int amount) {
+	for (int s = 0; s < COURT_MASK_SLOTS; s++) {
+		counts[s] += amount & -(int)((mask >> s) & 1);
+	}
+}
+
+// On/Off Table Constructor
+
+OnOffTable::OnOffTable() {
+
+	for (int s = 0; s < COURT_MASK_SLOTS; s++) {
+		onOffPossessions[s] = 0;
+		onDefPossessions[s] = 0;
+		onPointsFor[s] = 0;
+		onPointsAgainst[s] = 0;
+	}
+
+	team.offPossessions = 0;
+	team.defPossessions = 0;
+	team.pointsFor = 0;
+	team.pointsAgainst = 0;
+}
+
+// On/Off Functions
+
+void OnOffTable::offPossession(uint64_t mask) {
+	addMasked(onOffPossessions, mask, 1);
+	team.offPossessions++;
+}
+
+void OnOffTable::defPossession(uint64_t mask) {
+	addMasked(onDefPossessions, mask, 1);
+	team.defPossessions++;
+}
+
+void OnOffTable::score(uint64_t mask, int points) {
+	addMasked(onPointsFor, mask, points);
+	team.pointsFor += points;
+}
+
+void OnOffTable::scoredOn(uint64_t mask, int points) {
+	addMasked(onPointsAgainst, mask, points);
+	team.pointsAgainst += points;
+}
+
+// On/Off Getters
+
+OnOffTotals OnOffTable::getOnCourt(int slot) const {
+
+	OnOffTotals on = { 0, 0, 0, 0 };
+
+	if (slot < 0 || slot >= COURT_MASK_SLOTS) return on;
+
+	on.offPossessions = onOffPossessions[slot];
+	on.defPossessions = onDefPossessions[slot];
+	on.pointsFor = onPointsFor[slot];
+	on.pointsAgainst = onPointsAgainst[slot];
+
+	return on;
+}
+
+OnOffTotals OnOffTable::getOffCourt(int slot) const {
+
+	OnOffTotals on = getOnCourt(slot);
+	OnOffTotals off;
+
+	off.offPossessions = team.offPossessions - on.offPossessions;
+	off.defPossessions = team.defPossessions - on.defPossessions;
+	off.pointsFor = team.pointsFor - on.pointsFor;
+	off.pointsAgainst = team.pointsAgainst - on.pointsAgainst;
+
+	return off;
+}
+
+// On/Off Output
+
+/* Write on/off line for every roster Player of Team */
+static void writeTeamOnOff(std::string gameID, Team team,
+	const OnOffTable &table, std::ostream *onOffStream) {
+
+	for (Player player : team.getRoster()) {
+
+		OnOffTotals on = table.getOnCourt(player.getSlot());
+		OnOffTotals off = table.getOffCourt(player.getSlot());
+
+		double onOffRating = perHundred(on.pointsFor, on.offPossessions);
+		double onDefRating = perHundred(on.pointsAgainst, on.defPossessions);
+		double offOffRating = perHundred(off.pointsFor, off.offPossessions);
+		double offDefRating = perHundred(off.pointsAgainst,
+			off.defPossessions);
+
+		double netDiff = (onOffRating - onDefRating) -
+			(offOffRating - offDefRating);
+
+		*onOffStream << std::fixed << std::setprecision(1) << "\"" << gameID
+			<< "\",\"" << player.getPlayerID() << "\","
+			<< (on.offPossessions + on.defPossessions) << "," << onOffRating
+			<< "," << onDefRating << ","
+			<< (off.offPossessions + off.defPossessions) << ","
+			<< offOffRating << "," << offDefRating << "," << netDiff
+			<< std::endl;
+	}
+}
+
+void writeOnOffFile(std::vector<Game> *games, std::ostream *onOffStream) {
+
+	*onOffStream << "\"Game_id\",\"Person_id\",\"PossOn\",\"OffRtgOn\","
+		<< "\"DefRtgOn\",\"PossOff\",\"OffRtgOff\",\"DefRtgOff\",\"NetDiff\""
+		<< std::endl;
+
+	for (Game &game : *games) {
+		writeTeamOnOff(game.getGameID(), game.getHomeTeam(),
+			game.getHomeOnOff(), onOffStream);
+		writeTeamOnOff(game.getGameID(), game.getAwayTeam(),
+			game.getAwayOnOff(), onOffStream);
+	}
+}
@@ -0,0 +1,60 @@
+/* On/Off Ratings Header */
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#ifndef ONOFF_H_
+#define ONOFF_H_
+
+#include "team.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+
+class Game;
+
+/* Team possessions and points for one roster slot */
+struct OnOffTotals {
+	int offPossessions;
+	int defPossessions;
+	int pointsFor;
+	int pointsAgainst;
+};
+
+/* Team totals split by whether each roster slot was on court */
+// - Only on court totals are kept per slot, off court is Team minus on
+class OnOffTable {
+
+public:
+
+	OnOffTable();
+
+	/// On/Off Functions
+
+	/// Add to every slot in court mask (from Team::getCourtMask)
+	void offPossession(uint64_t mask);
+	void defPossession(uint64_t mask);
+
+	void score(uint64_t mask, int points);
+	void scoredOn(uint64_t mask, int points);
+
+	/// On/Off Getters
+
+	OnOffTotals getOnCourt(int slot) const;
+	OnOffTotals getOffCourt(int slot) const;
+
+private:
+
+	int onOffPossessions[COURT_MASK_SLOTS];
+	int onDefPossessions[COURT_MASK_SLOTS];
+	int onPointsFor[COURT_MASK_SLOTS];
+	int onPointsAgainst[COURT_MASK_SLOTS];
+
+	OnOffTotals team;	// Team totals, whoever was on court
+};
+
+/// Write on and off court ratings for every Player of every Game
+void writeOnOffFile(std::vector<Game> *games, std::ostream *onOffStream);
+
+#endif // ONOFF_H_
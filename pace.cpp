@@ -0,0 +1,156 @@
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#include "pace.hpp"
+#include "game.hpp"
+
+#include <iomanip>
+
+
+double perFortyEight(double possessions, int tenths) {
+	if (tenths <= 0) return 0.0;
+
+	return possessions * PACE_GAME_TENTHS / tenths;
+}
+
+// Pace Table Constructor
+
+PaceTable::PaceTable() {
+
+	for (int s = 0; s < COURT_MASK_SLOTS; s++) courtTime[s] = 0;
+	for (int b = 0; b < PACE_BINS; b++) bins[b] = 0;
+
+	teamTime = 0;
+	possessions = 0;
+	possessionTime = 0;
+}
+
+// Pace Functions
+
+void PaceTable::play(uint64_t mask, int tenths) {
+
+	// Branch free so the loop vectorizes over all slots
+	for (int s = 0; s < COURT_MASK_SLOTS; s++) {
+		courtTime[s] += tenths & -(int)((mask >> s) & 1);
+	}
+
+	teamTime += tenths;
+}
+
+void PaceTable::possession(int tenths) {
+
+	if (tenths < 0) tenths = 0;
+
+	int bin = tenths / PACE_BIN_WIDTH;
+
+	if (bin >= PACE_BINS) bin = PACE_BINS - 1;
+
+	bins[bin]++;
+
+	possessions++;
+	possessionTime += tenths;
+}
+
+// Pace Getters
+
+int PaceTable::getCourtTime(int slot) const {
+
+	if (slot < 0 || slot >= COURT_MASK_SLOTS) return 0;
+
+	return courtTime[slot];
+}
+
+int PaceTable::getTeamTime() const {
+	return teamTime;
+}
+
+int PaceTable::getPossessions() const {
+	return possessions;
+}
+
+int PaceTable::getPossessionTime() const {
+	return possessionTime;
+}
+
+int PaceTable::getBin(int bin) const {
+	return bins[bin];
+}
+
+// Pace Output
+
+/* Write pace line for every roster Player of Team */
+static void writeTeamPlayers(std::string gameID, Team team,
+	const PaceTable &table, std::ostream *paceStream) {
+
+	for (Player player : team.getRoster()) {
+
+		int tenths = table.getCourtTime(player.getSlot());
+
+		double possessions = (player.getOffPossessions() +
+			player.getDefPossessions()) / 2.0;
+
+		*paceStream << std::fixed << std::setprecision(1) << "\"" << gameID
+			<< "\",\"" << player.getPlayerID() << "\",\"" << team.getTeamID()
+			<< "\"," << (tenths / (double)TENTHS) << "," << possessions << ","
+			<< perFortyEight(possessions, tenths) << std::endl;
+	}
+}
+
+void writePaceFile(std::vector<Game> *games, std::ostream *paceStream) {
+
+	*paceStream << "\"Game_id\",\"Person_id\",\"Team_id\",\"Seconds\","
+		<< "\"Possessions\",\"Pace\"" << std::endl;
+
+	for (Game &game : *games) {
+		writeTeamPlayers(game.getGameID(), game.getHomeTeam(),
+			game.getHomePace(), paceStream);
+		writeTeamPlayers(game.getGameID(), game.getAwayTeam(),
+			game.getAwayPace(), paceStream);
+	}
+}
+
+/* Write pace line with duration histogram for Team */
+static void writeTeamLine(std::string gameID, Team team,
+	const PaceTable &table, std::ostream *paceStream) {
+
+	double possessions = (team.getOffPossessions() +
+		team.getDefPossessions()) / 2.0;
+
+	double duration = 0.0;
+
+	if (table.getPossessions() > 0) {
+		duration = table.getPossessionTime() /
+			(double)(table.getPossessions() * TENTHS);
+	}
+
+	*paceStream << std::fixed << std::setprecision(1) << "\"" << gameID
+		<< "\",\"" << team.getTeamID() << "\","
+		<< (table.getTeamTime() / (double)TENTHS) << "," << possessions << ","
+		<< perFortyEight(possessions, table.getTeamTime()) << ","
+		<< duration;
+
+	for (int b = 0; b < PACE_BINS; b++) *paceStream << "," << table.getBin(b);
+
+	*paceStream << std::endl;
+}
+
+void writeTeamPaceFile(std::vector<Game> *games, std::ostream *paceStream) {
+
+	*paceStream << "\"Game_id\",\"Team_id\",\"Seconds\",\"Possessions\","
+		<< "\"Pace\",\"AvgDuration\"";
+
+	// Bins named by lower bound in seconds, last one open ended
+	for (int b = 0; b < PACE_BINS; b++) {
+		*paceStream << ",\"Dur" << (b * PACE_BIN_WIDTH / TENTHS)
+			<< (b == PACE_BINS - 1 ? "+" : "") << "\"";
+	}
+
+	*paceStream << std::endl;
+
+	for (Game &game : *games) {
+		writeTeamLine(game.getGameID(), game.getHomeTeam(), game.getHomePace(),
+			paceStream);
+		writeTeamLine(game.getGameID(), game.getAwayTeam(), game.getAwayPace(),
+			paceStream);
+	}
+}
@@ -0,0 +1,67 @@
+/* Pace Header */
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#ifndef PACE_H_
+#define PACE_H_
+
+#include "team.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+
+// Pace Values
+#define PACE_GAME_TENTHS	28800	// 48 minutes in tenths of a second
+#define PACE_BIN_WIDTH		20		// Tenths of a second per duration bin
+#define PACE_BINS			16		// Last bin holds every longer possession
+
+class Game;
+
+/// Possessions per 48 minutes over tenths of game clock
+double perFortyEight(double possessions, int tenths);
+
+/* Game clock and possession durations for one Team of a Game */
+class PaceTable {
+
+public:
+
+	PaceTable();
+
+	/// Pace Functions
+
+	/// Add tenths of game clock to Team and every slot in court mask
+	void play(uint64_t mask, int tenths);
+
+	/// Add one possession of tenths duration
+	void possession(int tenths);
+
+	/// Pace Getters
+
+	int getCourtTime(int slot) const;
+	int getTeamTime() const;
+
+	int getPossessions() const;
+	int getPossessionTime() const;
+
+	int getBin(int bin) const;
+
+private:
+
+	int courtTime[COURT_MASK_SLOTS];	// Tenths on court by slot
+	int teamTime;						// Tenths of game clock played
+
+	int possessions;
+	int possessionTime;					// Tenths over all possessions
+
+	int bins[PACE_BINS];				// Possessions by duration bin
+};
+
+/// Write on court seconds, possessions and pace of every Player of every Game
+void writePaceFile(std::vector<Game> *games, std::ostream *paceStream);
+
+/// Write pace and possession duration histogram of every Team of every Game
+void writeTeamPaceFile(std::vector<Game> *games, std::ostream *paceStream);
+
+#endif // PACE_H_
@@ -0,0 +1,159 @@
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#include "pair.hpp"
+#include "game.hpp"
+
+#include <iomanip>
+#include <map>
+#include <string>
+
+
+/* Position of pair (a < b) in triangular matrix */
+static int pairIndex(int a, int b) {
+	return b * (b - 1) / 2 + a;
+}
+
+// Pair Table Constructor
+
+PairTable::PairTable(int slotCount) {
+
+	if (slotCount > COURT_MASK_SLOTS) slotCount = COURT_MASK_SLOTS;
+
+	slots = slotCount;
+
+	PairTotals empty = { 0, 0, 0, 0 };
+
+	pairs.assign(slots * (slots - 1) / 2, empty);
+}
+
+// Pair Functions
+
+void PairTable::addPairs(uint64_t mask, int PairTotals::*field, int amount) {
+
+	// A single slot has no pairs, and no row to point into
+	if (slots < 2) return;
+
+	if (slots < COURT_MASK_SLOTS) mask &= ((uint64_t)1 << slots) - 1;
+
+	uint64_t seen = 0; // Lower slots already walked, each pairs with b
+
+	while (mask != 0) {
+
+		int b = lowestCourtSlot(mask);
+		mask &= mask - 1;
+
+		PairTotals *row = &pairs[pairIndex(0, b)];
+
+		for (uint64_t partners = seen; partners != 0;
+			partners &= partners - 1) {
+
+			row[lowestCourtSlot(partners)].*field += amount;
+		}
+
+		seen |= (uint64_t)1 << b;
+	}
+}
+
+void PairTable::offPossession(uint64_t mask) {
+	addPairs(mask, &PairTotals::offPossessions, 1);
+}
+
+void PairTable::defPossession(uint64_t mask) {
+	addPairs(mask, &PairTotals::defPossessions, 1);
+}
+
+void PairTable::score(uint64_t mask, int points) {
+	addPairs(mask, &PairTotals::pointsFor, points);
+}
+
+void PairTable::scoredOn(uint64_t mask, int points) {
+	addPairs(mask, &PairTotals::pointsAgainst, points);
+}
+
+// Pair Getters
+
+int PairTable::getSlotCount() const {
+	return slots;
+}
+
+PairTotals PairTable::getPair(int a, int b) const {
+
+	if (a > b) return getPair(b, a);
+
+	return pairs[pairIndex(a, b)];
+}
+
+// Season Pair Output
+
+/* Pair totals summed over Games */
+struct SeasonPair {
+	int games;
+	PairTotals totals;
+};
+
+/* Add one Team's pairs from a Game to season pairs */
+static void addTeamPairs(std::map<std::string, SeasonPair> *season,
+	Team team, const PairTable &table) {
+
+	std::vector<std::string> slotIDs(table.getSlotCount());
+
+	for (Player player : team.getRoster()) {
+		if (player.getSlot() < table.getSlotCount()) {
+			slotIDs[player.getSlot()] = player.getPlayerID();
+		}
+	}
+
+	for (int b = 1; b < table.getSlotCount(); b++) {
+		for (int a = 0; a < b; a++) {
+
+			PairTotals pair = table.getPair(a, b);
+
+			if (pair.offPossessions == 0 && pair.defPossessions == 0) continue;
+
+			std::string first = slotIDs[a], second = slotIDs[b];
+
+			if (second < first) std::swap(first, second);
+
+			std::string key = "\"" + team.getTeamID() + "\",\"" + first +
+				"\",\"" + second + "\"";
+
+			SeasonPair &total = (*season)[key];
+
+			total.games++;
+			total.totals.offPossessions += pair.offPossessions;
+			total.totals.defPossessions += pair.defPossessions;
+			total.totals.pointsFor += pair.pointsFor;
+			total.totals.pointsAgainst += pair.pointsAgainst;
+		}
+	}
+}
+
+void writePairFile(std::vector<Game> *games, std::ostream *pairStream) {
+
+	std::map<std::string, SeasonPair> season;
+
+	for (Game &game : *games) {
+		addTeamPairs(&season, game.getHomeTeam(), game.getHomePairs());
+		addTeamPairs(&season, game.getAwayTeam(), game.getAwayPairs());
+	}
+
+	*pairStream << "\"Team_id\",\"Person1_id\",\"Person2_id\",\"Games\","
+		<< "\"OffPoss\",\"DefPoss\",\"PointsFor\",\"PointsAgainst\","
+		<< "\"OffRtg\",\"DefRtg\",\"NetRtg\"" << std::endl;
+
+	for (auto &entry : season) {
+
+		PairTotals totals = entry.second.totals;
+
+		double oRating = perHundred(totals.pointsFor, totals.offPossessions);
+		double dRating = perHundred(totals.pointsAgainst,
+			totals.defPossessions);
+
+		*pairStream << std::fixed << std::setprecision(1) << entry.first
+			<< "," << entry.second.games << "," << totals.offPossessions
+			<< "," << totals.defPossessions << "," << totals.pointsFor << ","
+			<< totals.pointsAgainst << "," << oRating << "," << dRating << ","
+			<< (oRating - dRating) << std::endl;
+	}
+}
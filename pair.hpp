@@ -0,0 +1,63 @@
+/* Pair Ratings Header */
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#ifndef PAIR_H_
+#define PAIR_H_
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+
+class Game;
+
+/* Possessions and points while two teammates shared the court */
+struct PairTotals {
+	int offPossessions;
+	int defPossessions;
+	int pointsFor;
+	int pointsAgainst;
+};
+
+/* Triangular matrix of pair totals over a Team's roster slots */
+// - Pairs are walked with bit scans over the court mask, so each event
+//   costs one update per pair on court whatever the roster size
+class PairTable {
+
+public:
+
+	PairTable() { slots = 0; }; // Default
+
+	/// Construct empty matrix for roster of slot count Players
+	PairTable(int slotCount);
+
+	/// Pair Functions
+
+	/// Add to every pair in court mask (from Team::getCourtMask)
+	void offPossession(uint64_t mask);
+	void defPossession(uint64_t mask);
+
+	void score(uint64_t mask, int points);
+	void scoredOn(uint64_t mask, int points);
+
+	/// Pair Getters
+
+	int getSlotCount() const;
+
+	/// Totals of slots a and b (order does not matter, a != b)
+	PairTotals getPair(int a, int b) const;
+
+private:
+
+	/// Add to one field of every pair in mask
+	void addPairs(uint64_t mask, int PairTotals::*field, int amount);
+
+	int slots;						// Roster slots in matrix
+	std::vector<PairTotals> pairs;	// Pair (i < j) at j * (j - 1) / 2 + i
+};
+
+/// Write season ratings of every teammate pair that shared the court
+void writePairFile(std::vector<Game> *games, std::ostream *pairStream);
+
+#endif // PAIR_H_
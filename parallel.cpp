@@ -0,0 +1,61 @@
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#include "parallel.hpp"
+
+#include <thread>
+#include <vector>
+
+
+int rangeCount(int count, int threads) {
+
+	if (threads < 1) threads = 1;
+	if (threads > count) threads = count;
+
+	return threads;
+}
+
+void parallelRanges(int count, int threads,
+	std::function<void(int, int, int)> work) {
+
+	threads = rangeCount(count, threads);
+
+	if (threads <= 1) {
+		if (count > 0) work(0, 0, count);
+		return;
+	}
+
+	std::vector<std::thread> running;
+
+	for (int t = 0; t < threads; t++) {
+
+		int begin = (long long)count * t / threads;
+		int end = (long long)count * (t + 1) / threads;
+
+		running.push_back(std::thread(work, t, begin, end));
+	}
+
+	for (std::thread &thread : running) thread.join();
+}
+
+ThreadBarrier::ThreadBarrier(int count) {
+	threads = count;
+	waiting = 0;
+	generation = 0;
+}
+
+void ThreadBarrier::wait() {
+
+	std::unique_lock<std::mutex> held(lock);
+
+	long arrived = generation;
+
+	if (++waiting == threads) {
+		waiting = 0;
+		generation++;
+		released.notify_all();
+		return;
+	}
+
+	released.wait(held, [this, arrived] { return generation != arrived; });
+}
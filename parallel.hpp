@@ -0,0 +1,42 @@
+/* Parallel Helpers Header */
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#ifndef PARALLEL_H_
+#define PARALLEL_H_
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+
+
+/// Split [0, count) into one contiguous range per thread and run work on
+/// each range in its own thread, called as work(thread, begin, end)
+// - Ranges are assigned in order, so range t always precedes range t + 1
+void parallelRanges(int count, int threads,
+	std::function<void(int, int, int)> work);
+
+/// Number of threads parallelRanges will use for count items
+int rangeCount(int count, int threads);
+
+/* Reusable barrier for the threads of one parallelRanges call */
+class ThreadBarrier {
+
+public:
+
+	ThreadBarrier(int count);
+
+	/// Block until every thread has called wait, then release them all
+	void wait();
+
+private:
+
+	std::mutex lock;
+	std::condition_variable released;
+
+	int threads;
+	int waiting;
+	long generation;	// Counts releases, so a late waker is not held
+};
+
+#endif // PARALLEL_H_
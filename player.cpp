@@ -15,6 +15,8 @@ Player::Player(std::string pid) {
 	defPossessions = 0;
 
 	active = false;
+
+	slot = NO_SLOT;
 }
 
 // Get Player Variables
@@ -39,6 +41,10 @@ int Player::getDefPossessions() {
 	return defPossessions;
 }
 
+int Player::getSlot() {
+	return slot;
+}
+
 bool Player::isActive() {
 	return active;
 }
@@ -77,6 +83,18 @@ void Player::deactivate() {
 	active = false;
 }
 
+void Player::setSlot(int s) {
+	slot = s;
+}
+
+void Player::setCounters(int pf, int pa, int op, int dp) {
+	pointsFor = pf;
+	pointsAgainst = pa;
+
+	offPossessions = op;
+	defPossessions = dp;
+}
+
 // Player Operators
 
 bool Player::operator==(Player p) {
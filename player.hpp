@@ -7,12 +7,15 @@
 
 #include <string>
 
+
+#define NO_SLOT	-1	// Player not on a Team roster
+
 /* Represents Player data and ID */
 class Player {
 
 public:
 
-	Player() {}; // Default
+	Player() { slot = NO_SLOT; }; // Default
 
 	/// Construct Player with ID
 	Player(std::string pid);
@@ -21,6 +24,8 @@ public:
 
 	std::string getPlayerID();
 
+	int getSlot();
+
 	int getPointsFor();
 	int getPointsAgainst();
 
@@ -43,6 +48,11 @@ public:
 	void activate();
 	void deactivate();
 
+	void setSlot(int s);
+
+	/// Restore counters saved from an earlier simulation
+	void setCounters(int pf, int pa, int op, int dp);
+
 	/// Player Operators
 
 	bool operator==(Player p);
@@ -59,6 +69,8 @@ private:
 
 	bool active;			// Active in Game
 
+	int slot;				// Index in Team roster (order Players were added)
+
 };
 
 #endif // PLAYER_H_
@@ -0,0 +1,278 @@
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#include "rapm.hpp"
+#include "parallel.hpp"
+
+#include <cmath>
+#include <iomanip>
+
+
+/* Global handle of every roster slot of Team */
+static std::vector<int> slotHandles(Team team, PlayerIndex *index) {
+
+	std::vector<int> handles(team.getTeamSize(), NO_HANDLE);
+
+	for (Player player : team.getRoster()) {
+		handles[player.getSlot()] = index->intern(player.getPlayerID());
+	}
+
+	return handles;
+}
+
+/* Add column entries for every court slot in mask */
+static void addCourt(StintMatrix *matrix, uint64_t mask,
+	std::vector<int> handles, double value) {
+
+	for (; mask != 0; mask &= mask - 1) {
+
+		int slot = lowestCourtSlot(mask);
+
+		if (slot >= handles.size()) continue;
+
+		matrix->column.push_back(handles[slot]);
+		matrix->value.push_back(value);
+	}
+}
+
+StintMatrix buildStintMatrix(std::vector<Game> *games, PlayerIndex *index) {
+
+	StintMatrix matrix;
+
+	matrix.rowStart.push_back(0);
+
+	for (Game &game : *games) {
+
+		std::vector<int> homeHandles = slotHandles(game.getHomeTeam(), index);
+		std::vector<int> awayHandles = slotHandles(game.getAwayTeam(), index);
+
+		for (Stint stint : game.getStints()) {
+
+			double possessions = (stint.homePossessions +
+				stint.awayPossessions) / 2.0;
+
+			if (possessions == 0) continue;
+
+			addCourt(&matrix, stint.homeMask, homeHandles, 1.0);
+			addCourt(&matrix, stint.awayMask, awayHandles, -1.0);
+
+			matrix.column.push_back(NO_HANDLE); // Home court, set below
+			matrix.value.push_back(1.0);
+
+			matrix.rowStart.push_back(matrix.column.size());
+			matrix.weight.push_back(possessions);
+			matrix.target.push_back(perHundred(stint.homePoints -
+				stint.awayPoints, possessions));
+		}
+	}
+
+	// Home court goes after every Player column
+	matrix.columns = index->size() + 1;
+
+	for (int i = 0; i < matrix.column.size(); i++) {
+		if (matrix.column[i] == NO_HANDLE) {
+			matrix.column[i] = matrix.columns - 1;
+		}
+	}
+
+	return matrix;
+}
+
+/* Sum of per-thread partials, in thread order */
+static double sumPartials(std::vector<double> *partial) {
+
+	double sum = 0.0;
+
+	for (double part : *partial) sum += part;
+
+	return sum;
+}
+
+/* Stint matrix transposed to compressed sparse column layout */
+struct ColumnMatrix {
+	std::vector<int> columnStart;
+	std::vector<int> row;
+	std::vector<double> value;
+};
+
+static ColumnMatrix transpose(StintMatrix *matrix) {
+
+	ColumnMatrix columns;
+
+	int rows = matrix->weight.size();
+
+	columns.columnStart.assign(matrix->columns + 1, 0);
+	columns.row.resize(matrix->column.size());
+	columns.value.resize(matrix->column.size());
+
+	for (int c : matrix->column) columns.columnStart[c + 1]++;
+
+	for (int c = 0; c < matrix->columns; c++) {
+		columns.columnStart[c + 1] += columns.columnStart[c];
+	}
+
+	std::vector<int> next(columns.columnStart.begin(),
+		columns.columnStart.end() - 1);
+
+	for (int r = 0; r < rows; r++) {
+		for (int i = matrix->rowStart[r]; i < matrix->rowStart[r + 1]; i++) {
+
+			int at = next[matrix->column[i]]++;
+
+			columns.row[at] = r;
+			columns.value[at] = matrix->value[i];
+		}
+	}
+
+	return columns;
+}
+
+RapmResult solveRapm(StintMatrix *matrix, double lambda, int threads) {
+
+	int rows = matrix->weight.size();
+	int n = matrix->columns;
+
+	ColumnMatrix columns = transpose(matrix);
+
+	std::vector<double> penalty(n, lambda);
+
+	penalty[n - 1] = 0.0; // Home court
+
+	std::vector<double> scratch(rows);
+
+	// Right hand side X'Wy
+	std::vector<double> b(n, 0.0);
+
+	for (int r = 0; r < rows; r++) {
+		scratch[r] = matrix->weight[r] * matrix->target[r];
+	}
+
+	for (int c = 0; c < n; c++) {
+		for (int i = columns.columnStart[c]; i < columns.columnStart[c + 1];
+			i++) {
+			b[c] += columns.value[i] * scratch[columns.row[i]];
+		}
+	}
+
+	RapmResult result;
+
+	std::vector<double> x(n, 0.0), r = b, p = b, ap(n, 0.0);
+
+	// Threads are started once and step through the iterations together,
+	// each owning one range of columns and one range of rows
+	int workers = rangeCount(n, threads);
+
+	ThreadBarrier barrier(workers);
+
+	std::vector<double> pap(workers), rrNext(workers);
+
+	result.iterations = 0;
+
+	parallelRanges(n, workers, [&](int thread, int begin, int end) {
+
+		int rowBegin = (long long)rows * thread / workers;
+		int rowEnd = (long long)rows * (thread + 1) / workers;
+
+		double part = 0.0;
+
+		for (int c = begin; c < end; c++) part += r[c] * r[c];
+
+		rrNext[thread] = part;
+
+		barrier.wait();
+
+		// Every thread sums the same partials, so all stop together
+		double rr = sumPartials(&rrNext);
+		double stop = RAPM_TOLERANCE * RAPM_TOLERANCE * rr;
+
+		int iterations = 0;
+
+		while (rr > stop && iterations < RAPM_MAX_ITERATIONS) {
+
+			// ap = (X'WX + penalty) p, rows then columns
+			for (int row = rowBegin; row < rowEnd; row++) {
+
+				double sum = 0.0;
+
+				for (int i = matrix->rowStart[row];
+					i < matrix->rowStart[row + 1]; i++) {
+					sum += matrix->value[i] * p[matrix->column[i]];
+				}
+
+				scratch[row] = matrix->weight[row] * sum;
+			}
+
+			barrier.wait();
+
+			part = 0.0;
+
+			for (int c = begin; c < end; c++) {
+
+				double sum = penalty[c] * p[c];
+
+				for (int i = columns.columnStart[c];
+					i < columns.columnStart[c + 1]; i++) {
+					sum += columns.value[i] * scratch[columns.row[i]];
+				}
+
+				ap[c] = sum;
+				part += p[c] * sum;
+			}
+
+			pap[thread] = part;
+
+			barrier.wait();
+
+			double alpha = rr / sumPartials(&pap);
+
+			part = 0.0;
+
+			for (int c = begin; c < end; c++) {
+				x[c] += alpha * p[c];
+				r[c] -= alpha * ap[c];
+				part += r[c] * r[c];
+			}
+
+			rrNext[thread] = part;
+
+			barrier.wait();
+
+			double rrNew = sumPartials(&rrNext);
+
+			for (int c = begin; c < end; c++) p[c] = r[c] + (rrNew / rr) * p[c];
+
+			rr = rrNew;
+			iterations++;
+
+			// Rows of the next iteration read every column of p
+			barrier.wait();
+		}
+
+		if (thread == 0) result.iterations = iterations;
+	});
+
+	result.homeCourt = x[n - 1];
+	result.ratings.assign(x.begin(), x.end() - 1);
+	result.possessions.assign(n - 1, 0.0);
+
+	for (int c = 0; c < n - 1; c++) {
+		for (int i = columns.columnStart[c]; i < columns.columnStart[c + 1];
+			i++) {
+			result.possessions[c] += matrix->weight[columns.row[i]];
+		}
+	}
+
+	return result;
+}
+
+void writeRapmFile(RapmResult result, PlayerIndex *index,
+	std::ostream *rapmStream) {
+
+	*rapmStream << "\"Person_id\",\"Possessions\",\"RAPM\"" << std::endl;
+
+	for (int h = 0; h < result.ratings.size(); h++) {
+		*rapmStream << std::fixed << std::setprecision(1) << "\""
+			<< index->getPlayerID(h) << "\"," << result.possessions[h] << ","
+			<< std::setprecision(2) << result.ratings[h] << std::endl;
+	}
+}
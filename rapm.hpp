@@ -0,0 +1,54 @@
+/* Adjusted Plus-Minus Header */
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#ifndef RAPM_H_
+#define RAPM_H_
+
+#include "game.hpp"
+#include "season.hpp"
+
+#include <iostream>
+#include <vector>
+
+
+// Ridge Regression Values
+#define RAPM_LAMBDA				2000.0	// Penalty on every Player column
+#define RAPM_TOLERANCE			1e-8	// Stop at this relative residual
+#define RAPM_MAX_ITERATIONS		1000
+
+/* Stint design matrix in compressed sparse row layout */
+// - One row per stint with possessions, +1 for home Players, -1 for away
+//   Players and 1 in the last column, which models home court
+struct StintMatrix {
+	int columns;					// Interned Players plus home court
+
+	std::vector<int> rowStart;		// Row r is [rowStart[r], rowStart[r + 1])
+	std::vector<int> column;
+	std::vector<double> value;
+
+	std::vector<double> weight;		// Possessions per team in stint
+	std::vector<double> target;		// Home net points per 100 possessions
+};
+
+/* Ridge regularized adjusted plus-minus solution */
+struct RapmResult {
+	std::vector<double> ratings;		// Net points per 100, by handle
+	std::vector<double> possessions;	// Weighted possessions, by handle
+
+	double homeCourt;	// Home court advantage per 100 possessions
+	int iterations;		// Conjugate gradient iterations used
+};
+
+/// Build stint rows of every Game, interning Players into index
+StintMatrix buildStintMatrix(std::vector<Game> *games, PlayerIndex *index);
+
+/// Solve (X'WX + lambda I) b = X'Wy with multithreaded conjugate gradient
+// - Home court column is not penalized
+RapmResult solveRapm(StintMatrix *matrix, double lambda, int threads);
+
+/// Write RAPM of every interned Player
+void writeRapmFile(RapmResult result, PlayerIndex *index,
+	std::ostream *rapmStream);
+
+#endif // RAPM_H_
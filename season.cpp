@@ -0,0 +1,153 @@
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#include "season.hpp"
+#include "parallel.hpp"
+
+#include <iomanip>
+
+
+// Player Index Functions
+
+int PlayerIndex::intern(std::string playerID) {
+
+	auto found = handles.find(playerID);
+
+	if (found != handles.end()) return found->second;
+
+	int handle = playerIDs.size();
+
+	handles[playerID] = handle;
+	playerIDs.push_back(playerID);
+
+	return handle;
+}
+
+int PlayerIndex::find(std::string playerID) {
+
+	auto found = handles.find(playerID);
+
+	if (found == handles.end()) return NO_HANDLE;
+
+	return found->second;
+}
+
+std::string PlayerIndex::getPlayerID(int handle) {
+	return playerIDs[handle];
+}
+
+int PlayerIndex::size() {
+	return playerIDs.size();
+}
+
+// Season Aggregation
+
+/* Add one Game's Player counters to totals */
+static void addPlayer(SeasonTotals *totals, Player player) {
+
+	if (player.getOffPossessions() != 0 || player.getDefPossessions() != 0) {
+		totals->games++;
+	}
+
+	totals->pointsFor += player.getPointsFor();
+	totals->pointsAgainst += player.getPointsAgainst();
+	totals->offPossessions += player.getOffPossessions();
+	totals->defPossessions += player.getDefPossessions();
+}
+
+/* Partial table filled by one thread, keyed by thread-local handle */
+struct SeasonPartial {
+	PlayerIndex local;
+	std::vector<SeasonTotals> totals;
+	std::vector<int> globalHandles;	// Global handle of each local handle
+};
+
+static void addTeam(SeasonPartial *partial, Team team) {
+
+	SeasonTotals empty = { 0, 0, 0, 0, 0 };
+
+	for (Player player : team.getRoster()) {
+
+		int handle = partial->local.intern(player.getPlayerID());
+
+		if (handle == partial->totals.size()) partial->totals.push_back(empty);
+
+		addPlayer(&partial->totals[handle], player);
+	}
+}
+
+std::vector<SeasonTotals> aggregateSeason(std::vector<Game> *games,
+	PlayerIndex *index, int threads) {
+
+	threads = rangeCount(games->size(), threads);
+
+	std::vector<SeasonPartial> partials(threads);
+
+	// Each thread sums its own range of Games
+	parallelRanges(games->size(), threads,
+		[games, &partials](int thread, int begin, int end) {
+
+		for (int i = begin; i < end; i++) {
+			addTeam(&partials[thread], (*games)[i].getHomeTeam());
+			addTeam(&partials[thread], (*games)[i].getAwayTeam());
+		}
+	});
+
+	// Intern in thread order, so handles follow first appearance in Games
+	for (SeasonPartial &partial : partials) {
+		for (int i = 0; i < partial.local.size(); i++) {
+			partial.globalHandles.push_back(
+				index->intern(partial.local.getPlayerID(i)));
+		}
+	}
+
+	SeasonTotals empty = { 0, 0, 0, 0, 0 };
+
+	std::vector<SeasonTotals> season(index->size(), empty);
+
+	// Merge with each thread owning one range of global handles, taking
+	// only the entries of every partial table that fall in its range
+	parallelRanges(season.size(), threads,
+		[&partials, &season](int, int begin, int end) {
+
+		for (SeasonPartial &partial : partials) {
+			for (int i = 0; i < partial.totals.size(); i++) {
+
+				int h = partial.globalHandles[i];
+
+				if (h < begin || h >= end) continue;
+
+				season[h].games += partial.totals[i].games;
+				season[h].pointsFor += partial.totals[i].pointsFor;
+				season[h].pointsAgainst += partial.totals[i].pointsAgainst;
+				season[h].offPossessions += partial.totals[i].offPossessions;
+				season[h].defPossessions += partial.totals[i].defPossessions;
+			}
+		}
+	});
+
+	return season;
+}
+
+void writeSeasonFile(std::vector<SeasonTotals> totals, PlayerIndex *index,
+	std::ostream *seasonStream) {
+
+	*seasonStream << "\"Person_id\",\"Games\",\"OffPoss\",\"DefPoss\","
+		<< "\"PointsFor\",\"PointsAgainst\",\"OffRtg\",\"DefRtg\",\"NetRtg\""
+		<< std::endl;
+
+	for (int h = 0; h < totals.size(); h++) {
+
+		double oRating = perHundred(totals[h].pointsFor,
+			totals[h].offPossessions);
+		double dRating = perHundred(totals[h].pointsAgainst,
+			totals[h].defPossessions);
+
+		*seasonStream << std::fixed << std::setprecision(1) << "\""
+			<< index->getPlayerID(h) << "\"," << totals[h].games << ","
+			<< totals[h].offPossessions << "," << totals[h].defPossessions
+			<< "," << totals[h].pointsFor << "," << totals[h].pointsAgainst
+			<< "," << oRating << "," << dRating << ","
+			<< (oRating - dRating) << std::endl;
+	}
+}
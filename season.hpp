@@ -0,0 +1,63 @@
+/* Season Aggregation Header */
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#ifndef SEASON_H_
+#define SEASON_H_
+
+#include "game.hpp"
+
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+#define NO_HANDLE	-1
+
+/* Interned Player IDs, numbered densely in order of first appearance */
+class PlayerIndex {
+
+public:
+
+	PlayerIndex() {}; // Default
+
+	/// Index Functions
+
+	/// Return handle of Player ID, adding it if new
+	int intern(std::string playerID);
+
+	/// Return handle of Player ID, NO_HANDLE if never interned
+	int find(std::string playerID);
+
+	std::string getPlayerID(int handle);
+
+	int size();
+
+private:
+
+	std::unordered_map<std::string, int> handles;	// Handles by Player ID
+	std::vector<std::string> playerIDs;				// Player IDs by handle
+};
+
+/* Counters of one Player summed over Games */
+struct SeasonTotals {
+	int games;	// Games with at least one possession
+	int pointsFor;
+	int pointsAgainst;
+	int offPossessions;
+	int defPossessions;
+};
+
+/// Sum every Player's counters across Games, indexed by interned handle
+// - Each thread fills a partial table for its range of Games, then the
+//   handle range is split across threads, each merging the partial
+//   entries it owns
+std::vector<SeasonTotals> aggregateSeason(std::vector<Game> *games,
+	PlayerIndex *index, int threads);
+
+/// Write season OffRtg, DefRtg and net rating of every Player
+void writeSeasonFile(std::vector<SeasonTotals> totals, PlayerIndex *index,
+	std::ostream *seasonStream);
+
+#endif // SEASON_H_
@@ -0,0 +1,446 @@
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#include "server.hpp"
+
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+
+static volatile sig_atomic_t serverInterrupted = 0;
+
+static void interruptServer(int) {
+	serverInterrupted = 1;
+}
+
+static void setNonBlocking(int fd) {
+	fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+}
+
+/* Add one Game's Player counters to totals */
+static void addTotals(RatingTotals *totals, Player player) {
+	totals->games++;
+	totals->pointsFor += player.getPointsFor();
+	totals->pointsAgainst += player.getPointsAgainst();
+	totals->offPossessions += player.getOffPossessions();
+	totals->defPossessions += player.getDefPossessions();
+}
+
+/* Format totals as "OffRtg DefRtg PtsFor PtsAgainst OffPoss DefPoss" */
+static std::string formatTotals(RatingTotals totals) {
+
+	std::ostringstream reply;
+
+	reply << std::fixed << std::setprecision(1)
+		<< perHundred(totals.pointsFor, totals.offPossessions) << " "
+		<< perHundred(totals.pointsAgainst, totals.defPossessions) << " "
+		<< totals.pointsFor << " " << totals.pointsAgainst << " "
+		<< totals.offPossessions << " " << totals.defPossessions;
+
+	return reply.str();
+}
+
+// Rating Server Constructor
+
+RatingServer::RatingServer(std::vector<Game> games) {
+
+	nextClientID = 0;
+	stopping = false;
+
+	wakePipe[0] = -1;
+	wakePipe[1] = -1;
+
+	RatingTotals empty = { 0, 0, 0, 0, 0 };
+
+	for (Game game : games) {
+
+		Team home = game.getHomeTeam();
+		Team away = game.getAwayTeam();
+
+		GameSummary summary;
+
+		summary.homeTeamID = home.getTeamID();
+		summary.awayTeamID = away.getTeamID();
+		summary.homeScore = home.getScore();
+		summary.awayScore = away.getScore();
+		summary.homePossessions = home.getOffPossessions();
+		summary.awayPossessions = away.getOffPossessions();
+		summary.playerCount = home.getTeamSize() + away.getTeamSize();
+
+		gameSummaries[game.getGameID()] = summary;
+
+		std::vector<Player> players = home.getRoster();
+		std::vector<Player> awayPlayers = away.getRoster();
+
+		players.insert(players.end(), awayPlayers.begin(), awayPlayers.end());
+
+		for (Player player : players) {
+
+			RatingTotals gameTotals = empty;
+
+			addTotals(&gameTotals, player);
+
+			gameRatings[game.getGameID() + " " + player.getPlayerID()] =
+				gameTotals;
+
+			if (seasonTotals.find(player.getPlayerID()) == seasonTotals.end()) {
+				seasonTotals[player.getPlayerID()] = empty;
+			}
+
+			addTotals(&seasonTotals[player.getPlayerID()], player);
+		}
+	}
+}
+
+// Server Functions
+
+std::string RatingServer::answer(std::string request) {
+
+	std::istringstream tokens(request);
+
+	std::string command, firstID, secondID;
+
+	tokens >> command >> firstID >> secondID;
+
+	if (command == REQUEST_GAME && firstID != "") {
+
+		auto found = gameSummaries.find(firstID);
+
+		if (found == gameSummaries.end()) return "ERR unknown game";
+
+		GameSummary summary = found->second;
+
+		std::ostringstream reply;
+
+		reply << "OK " << firstID << " " << summary.homeTeamID << " "
+			<< summary.homeScore << " " << summary.homePossessions << " "
+			<< summary.awayTeamID << " " << summary.awayScore << " "
+			<< summary.awayPossessions << " " << summary.playerCount;
+
+		return reply.str();
+	}
+	else if (command == REQUEST_RATING && secondID != "") {
+
+		auto found = gameRatings.find(firstID + " " + secondID);
+
+		if (found == gameRatings.end()) return "ERR unknown game or player";
+
+		return "OK " + firstID + " " + secondID + " " +
+			formatTotals(found->second);
+	}
+	else if (command == REQUEST_PLAYER && firstID != "") {
+
+		auto found = seasonTotals.find(firstID);
+
+		if (found == seasonTotals.end()) return "ERR unknown player";
+
+		return "OK " + firstID + " " + std::to_string(found->second.games) +
+			" " + formatTotals(found->second);
+	}
+
+	return "ERR bad request";
+}
+
+void RatingServer::workerLoop() {
+
+	while (true) {
+
+		ServerJob job;
+
+		{
+			std::unique_lock<std::mutex> lock(jobLock);
+
+			jobReady.wait(lock, [this] { return stopping || !jobs.empty(); });
+
+			if (stopping) return;
+
+			job = jobs.front();
+			jobs.pop_front();
+		}
+
+		job.text = answer(job.text) + "\n";
+
+		{
+			std::lock_guard<std::mutex> lock(jobLock);
+			replies.push_back(job);
+		}
+
+		char wake = 0;
+		while (write(wakePipe[1], &wake, 1) < 0 && errno == EINTR) {}
+	}
+}
+
+/* Hand client's next request to the worker pool */
+void RatingServer::submit(uint64_t clientID, ServerClient *client) {
+
+	if (client->busy || client->requests.empty()) return;
+
+	ServerJob job;
+
+	job.clientID = clientID;
+	job.text = client->requests.front();
+
+	client->requests.pop_front();
+	client->busy = true;
+
+	{
+		std::lock_guard<std::mutex> lock(jobLock);
+		jobs.push_back(job);
+	}
+
+	jobReady.notify_one();
+}
+
+/* Move finished replies into client output buffers */
+void RatingServer::collectReplies() {
+
+	char drain[SERVER_READ_SIZE];
+	while (read(wakePipe[0], drain, sizeof(drain)) > 0) {}
+
+	std::deque<ServerJob> done;
+
+	{
+		std::lock_guard<std::mutex> lock(jobLock);
+		done.swap(replies);
+	}
+
+	for (ServerJob job : done) {
+
+		auto found = clients.find(job.clientID);
+
+		if (found == clients.end()) continue; // Client already left
+
+		found->second.output += job.text;
+		found->second.busy = false;
+
+		submit(job.clientID, &found->second);
+	}
+}
+
+bool RatingServer::acceptClient(int listenFd) {
+
+	int fd = accept(listenFd, NULL, NULL);
+
+	if (fd < 0) return false;
+
+	setNonBlocking(fd);
+
+	ServerClient client;
+
+	client.fd = fd;
+	client.busy = false;
+	client.closing = false;
+	client.ended = false;
+
+	clients[nextClientID++] = client;
+
+	return true;
+}
+
+/* Checks if client has nothing left to send or to be answered */
+static bool isClientDone(ServerClient *client) {
+	return client->output.empty() && (client->closing || (client->ended &&
+		!client->busy && client->requests.empty()));
+}
+
+/* Read request lines, return false once client should be dropped */
+bool RatingServer::readClient(uint64_t clientID, ServerClient *client) {
+
+	if (client->ended) return !isClientDone(client);
+
+	char buffer[SERVER_READ_SIZE];
+
+	ssize_t count = read(client->fd, buffer, sizeof(buffer));
+
+	if (count < 0) return errno == EAGAIN || errno == EINTR;
+
+	// Client only stopped sending, its queued requests are still answered
+	if (count == 0) {
+		client->ended = true;
+
+		if (!client->input.empty() && !client->closing) {
+			client->requests.push_back(client->input);
+			client->input.clear();
+		}
+
+		submit(clientID, client);
+
+		return !isClientDone(client);
+	}
+
+	client->input.append(buffer, count);
+
+	std::size_t end;
+
+	while ((end = client->input.find('\n')) != std::string::npos) {
+
+		std::string line = client->input.substr(0, end);
+
+		if (!line.empty() && line[line.length() - 1] == '\r') {
+			line.erase(line.length() - 1);
+		}
+
+		client->input.erase(0, end + 1);
+
+		if (!line.empty()) client->requests.push_back(line);
+	}
+
+	if (client->input.length() > SERVER_MAX_LINE) {
+		client->output += "ERR request too long\n";
+		client->closing = true;
+	}
+
+	submit(clientID, client);
+
+	return true;
+}
+
+/* Flush buffered output, return false once client should be dropped */
+bool RatingServer::writeClient(ServerClient *client) {
+
+	ssize_t count = send(client->fd, client->output.data(),
+		client->output.length(), MSG_NOSIGNAL);
+
+	if (count < 0) return errno == EAGAIN || errno == EINTR;
+
+	client->output.erase(0, count);
+
+	return !isClientDone(client);
+}
+
+bool RatingServer::serve(std::string socketPath, int workerCount) {
+
+	struct sockaddr_un address;
+
+	if (socketPath.length() >= sizeof(address.sun_path)) {
+		std::cerr << "Socket path too long: " << socketPath << std::endl;
+		return false;
+	}
+
+	std::memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	std::strcpy(address.sun_path, socketPath.c_str());
+
+	int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+	if (listenFd < 0) return false;
+
+	unlink(socketPath.c_str());
+
+	if (bind(listenFd, (struct sockaddr *)&address, sizeof(address)) != 0 ||
+		listen(listenFd, SERVER_BACKLOG) != 0 || pipe(wakePipe) != 0) {
+
+		std::cerr << "Could not listen on " << socketPath << ": "
+			<< std::strerror(errno) << std::endl;
+
+		close(listenFd);
+		return false;
+	}
+
+	setNonBlocking(listenFd);
+	setNonBlocking(wakePipe[0]);
+
+	serverInterrupted = 0;
+	signal(SIGINT, interruptServer);
+	signal(SIGTERM, interruptServer);
+
+	if (workerCount < 1) workerCount = 1;
+
+	for (int i = 0; i < workerCount; i++) {
+		workers.push_back(std::thread(&RatingServer::workerLoop, this));
+	}
+
+	std::cout << "Serving " << gameSummaries.size() << " games on "
+		<< socketPath << std::endl;
+
+	std::vector<struct pollfd> polled;
+	std::vector<uint64_t> polledIDs;
+
+	while (!serverInterrupted) {
+
+		polled.clear();
+		polledIDs.clear();
+
+		struct pollfd listenPoll = { listenFd, POLLIN, 0 };
+		struct pollfd wakePoll = { wakePipe[0], POLLIN, 0 };
+
+		polled.push_back(listenPoll);
+		polled.push_back(wakePoll);
+
+		for (auto &entry : clients) {
+
+			struct pollfd clientPoll = { entry.second.fd, 0, 0 };
+
+			if (!entry.second.closing && !entry.second.ended) {
+				clientPoll.events |= POLLIN;
+			}
+			if (!entry.second.output.empty()) clientPoll.events |= POLLOUT;
+
+			polled.push_back(clientPoll);
+			polledIDs.push_back(entry.first);
+		}
+
+		if (poll(polled.data(), polled.size(), SERVER_POLL_TIMEOUT) <= 0) {
+			continue;
+		}
+
+		if (polled[1].revents & POLLIN) collectReplies();
+
+		for (int i = 0; i < polledIDs.size(); i++) {
+
+			auto found = clients.find(polledIDs[i]);
+			short events = polled[i + 2].revents;
+
+			if (found == clients.end() || events == 0) continue;
+
+			bool keep = true;
+
+			if (events & (POLLIN | POLLHUP | POLLERR)) {
+				keep = readClient(found->first, &found->second);
+			}
+			if (keep && !found->second.output.empty()) {
+				keep = writeClient(&found->second);
+			}
+
+			if (!keep) {
+				close(found->second.fd);
+				clients.erase(found);
+			}
+		}
+
+		if (polled[0].revents & POLLIN) {
+			while (acceptClient(listenFd)) {}
+		}
+	}
+
+	// Stop workers and close every connection
+	{
+		std::lock_guard<std::mutex> lock(jobLock);
+		stopping = true;
+	}
+	jobReady.notify_all();
+
+	for (std::thread &worker : workers) worker.join();
+	workers.clear();
+
+	for (auto &entry : clients) close(entry.second.fd);
+	clients.clear();
+
+	close(listenFd);
+	close(wakePipe[0]);
+	close(wakePipe[1]);
+
+	unlink(socketPath.c_str());
+
+	return true;
+}
@@ -0,0 +1,123 @@
+/* Rating Server Header */
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#ifndef SERVER_H_
+#define SERVER_H_
+
+#include "game.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+
+// Server Values
+#define SERVER_BACKLOG			64
+#define SERVER_READ_SIZE		4096
+#define SERVER_MAX_LINE			1024
+#define SERVER_POLL_TIMEOUT		500		// Milliseconds between stop checks
+
+// Server Requests
+#define REQUEST_GAME	"GAME"		// GAME <game_id>
+#define REQUEST_RATING	"RATING"	// RATING <game_id> <player_id>
+#define REQUEST_PLAYER	"PLAYER"	// PLAYER <player_id>
+
+/* Points and possessions for a Player over one or more Games */
+struct RatingTotals {
+	int games;
+	int pointsFor;
+	int pointsAgainst;
+	int offPossessions;
+	int defPossessions;
+};
+
+/* Score and possessions for both Teams of a Game */
+struct GameSummary {
+	std::string homeTeamID;
+	std::string awayTeamID;
+
+	int homeScore;
+	int awayScore;
+
+	int homePossessions;
+	int awayPossessions;
+
+	int playerCount;
+};
+
+/* Request line waiting for, or answered by, a worker */
+struct ServerJob {
+	uint64_t clientID;
+	std::string text;
+};
+
+/* Connected client with its buffered input and output */
+struct ServerClient {
+	int fd;
+
+	std::string input;
+	std::string output;
+
+	std::deque<std::string> requests;	// Lines waiting for a worker
+
+	bool busy;		// Request handed to a worker, keeps replies in order
+	bool closing;	// Close once output is flushed
+	bool ended;		// Client sent EOF, close once every reply is flushed
+};
+
+/* Answers rating queries for simulated Games over a Unix domain socket */
+// - The event loop owns every socket, workers only read the indexes,
+//   which are never modified once the server is constructed.
+class RatingServer {
+
+public:
+
+	/// Construct Server indexes from simulated Games
+	RatingServer(std::vector<Game> games);
+
+	/// Server Functions
+
+	/// Serve requests on socket path until interrupted
+	bool serve(std::string socketPath, int workers);
+
+	/// Answer one request line
+	std::string answer(std::string request);
+
+private:
+
+	void workerLoop();
+
+	void submit(uint64_t clientID, ServerClient *client);
+
+	void collectReplies();
+
+	bool acceptClient(int listenFd);
+	bool readClient(uint64_t clientID, ServerClient *client);
+	bool writeClient(ServerClient *client);
+
+	std::unordered_map<std::string, GameSummary> gameSummaries;
+	std::unordered_map<std::string, RatingTotals> gameRatings;
+	std::unordered_map<std::string, RatingTotals> seasonTotals;
+
+	std::map<uint64_t, ServerClient> clients;	// Clients by connection ID
+	uint64_t nextClientID;
+
+	std::vector<std::thread> workers;
+
+	std::mutex jobLock;
+	std::condition_variable jobReady;
+	std::deque<ServerJob> jobs;
+	std::deque<ServerJob> replies;
+	bool stopping;
+
+	int wakePipe[2];	// Workers wake the event loop when replies are ready
+};
+
+#endif // SERVER_H_
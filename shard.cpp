@@ -0,0 +1,330 @@
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#include "shard.hpp"
+#include "cache.hpp"
+#include "engine.hpp"
+#include "season.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+/* Write text to path through a temporary file, so readers never see part */
+static bool replaceFile(std::string path, std::string text) {
+
+	// Workers may write the same manifest at once, each uses its own file
+	std::string tmpPath = path + ".tmp." + std::to_string(getpid());
+
+	// Parent may be a shard directory not made yet, an existing one is kept
+	if (path.rfind('/') != std::string::npos) {
+		mkdir(path.substr(0, path.rfind('/')).c_str(), 0755);
+	}
+
+	std::ofstream file(tmpPath.c_str());
+
+	file << text;
+	file.close();
+
+	if (file.fail() || std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+		std::remove(tmpPath.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+/* Game ID leading a Game File or Play File line */
+static std::string lineGameID(std::string line) {
+	return cleanString(line.substr(0, line.find('\t')));
+}
+
+std::vector<std::string> loadManifest(std::string manifestPath,
+	std::istream *gameStream) {
+
+	std::vector<std::string> manifest;
+
+	std::string line;
+
+	std::ifstream manifestFile(manifestPath.c_str());
+
+	if (manifestFile.is_open()) {
+		while (getline(manifestFile, line)) {
+			if (line != "") manifest.push_back(line);
+		}
+
+		return manifest;
+	}
+
+	// Game File lines of a Game are contiguous
+	std::string text;
+
+	while (getline(*gameStream, line)) {
+
+		if (!isValidLine(line)) continue;
+
+		std::string gameID = lineGameID(line);
+
+		if (manifest.empty() || manifest.back() != gameID) {
+			manifest.push_back(gameID);
+			text += gameID + "\n";
+		}
+	}
+
+	gameStream->clear();
+	gameStream->seekg(0);
+
+	if (manifest.empty()) return manifest;
+
+	if (!replaceFile(manifestPath, text)) {
+		std::cerr << "Could not write manifest " << manifestPath << std::endl;
+		manifest.clear();
+	}
+
+	return manifest;
+}
+
+std::string shardPath(std::string shardDir, int shard) {
+	return shardDir + "/" + SHARD_PREFIX + std::to_string(shard) + SHARD_EXT;
+}
+
+bool runShard(std::istream *gameStream, std::istream *playStream,
+	std::vector<std::string> manifest, int shard, int shards,
+	std::string shardDir) {
+
+	// Same contiguous split as parallelRanges
+	int begin = (long long)manifest.size() * shard / shards;
+	int end = (long long)manifest.size() * (shard + 1) / shards;
+
+	std::unordered_set<std::string> owned(manifest.begin() + begin,
+		manifest.begin() + end);
+
+	std::string gameLines, playLines, line;
+
+	// Lines of other shards are dropped by their leading Game ID, so only
+	// the lines of owned Games are tokenized. Header lines are never owned.
+	while (getline(*gameStream, line)) {
+		if (owned.count(lineGameID(line)) > 0) gameLines += line + "\n";
+	}
+
+	while (getline(*playStream, line)) {
+		if (owned.count(lineGameID(line)) > 0) playLines += line + "\n";
+	}
+
+	std::vector<Game> games = runGamesFromBuffers(gameLines, playLines);
+
+	PlayerIndex index;
+
+	std::vector<SeasonTotals> season = aggregateSeason(&games, &index, 1);
+
+	std::ostringstream shardStream;
+
+	shardStream << SHARD_HEADER << " " << ENGINE_VERSION << " " << shard << " "
+		<< shards << "\n";
+
+	for (Game &game : games) {
+		shardStream << "G " << game.getGameID() << "\n";
+
+		saveTeam(game.getHomeTeam(), &shardStream);
+		saveTeam(game.getAwayTeam(), &shardStream);
+	}
+
+	for (int h = 0; h < season.size(); h++) {
+		shardStream << "S " << index.getPlayerID(h) << " " << season[h].games
+			<< " " << season[h].pointsFor << " " << season[h].pointsAgainst
+			<< " " << season[h].offPossessions << " "
+			<< season[h].defPossessions << "\n";
+	}
+
+	shardStream << "E " << games.size() << " " << season.size() << "\n";
+
+	if (!replaceFile(shardPath(shardDir, shard), shardStream.str())) {
+		std::cerr << "Could not write shard " << shardPath(shardDir, shard)
+			<< std::endl;
+		return false;
+	}
+
+	std::cout << "Shard " << shard << " of " << shards << ": " << games.size()
+		<< " of " << (end - begin) << " games" << std::endl;
+
+	return true;
+}
+
+/* Read partial output of one shard, adding its Games and season totals */
+static bool loadShard(std::string path, int shard, int shards,
+	std::unordered_map<std::string, Game> *games, PlayerIndex *index,
+	std::vector<SeasonTotals> *season) {
+
+	std::ifstream shardFile(path.c_str());
+
+	std::string header, version;
+	int fileShard, fileShards;
+
+	if (!(shardFile >> header >> version >> fileShard >> fileShards) ||
+		header != SHARD_HEADER || version != ENGINE_VERSION ||
+		fileShard != shard || fileShards != shards) {
+		return false;
+	}
+
+	std::string tag;
+
+	int gameCount = 0, playerCount = 0;
+
+	while (shardFile >> tag) {
+
+		if (tag == "G") {
+			std::string gameID;
+			Team home, away;
+
+			if (!(shardFile >> gameID) || !loadTeam(&shardFile, &home) ||
+				!loadTeam(&shardFile, &away)) {
+				return false;
+			}
+
+			(*games)[gameID] = Game(gameID, home, away);
+			gameCount++;
+		}
+		else if (tag == "S") {
+			std::string playerID;
+			SeasonTotals totals;
+
+			if (!(shardFile >> playerID >> totals.games >> totals.pointsFor
+				>> totals.pointsAgainst >> totals.offPossessions
+				>> totals.defPossessions)) {
+				return false;
+			}
+
+			int handle = index->intern(playerID);
+
+			if (handle == season->size()) {
+				SeasonTotals empty = { 0, 0, 0, 0, 0 };
+
+				season->push_back(empty);
+			}
+
+			(*season)[handle].games += totals.games;
+			(*season)[handle].pointsFor += totals.pointsFor;
+			(*season)[handle].pointsAgainst += totals.pointsAgainst;
+			(*season)[handle].offPossessions += totals.offPossessions;
+			(*season)[handle].defPossessions += totals.defPossessions;
+
+			playerCount++;
+		}
+		else if (tag == "E") {
+			int games, players;
+
+			// Counts guard against a shard cut short
+			return (shardFile >> games >> players) && games == gameCount &&
+				players == playerCount;
+		}
+		else return false;
+	}
+
+	return false;
+}
+
+bool mergeShards(std::vector<std::string> manifest, int shards,
+	std::string shardDir, std::ostream *dataStream,
+	std::ostream *seasonStream) {
+
+	std::unordered_map<std::string, Game> merged;
+
+	PlayerIndex index;
+
+	std::vector<SeasonTotals> season;
+
+	for (int shard = 0; shard < shards; shard++) {
+
+		if (!loadShard(shardPath(shardDir, shard), shard, shards, &merged,
+			&index, &season)) {
+			std::cerr << "Shard " << shardPath(shardDir, shard)
+				<< " is missing or incomplete" << std::endl;
+			return false;
+		}
+	}
+
+	std::vector<Game> games;
+
+	bool complete = true;
+
+	for (std::string gameID : manifest) {
+
+		auto found = merged.find(gameID);
+
+		if (found == merged.end()) {
+			std::cerr << "No shard output for game " << gameID << std::endl;
+			complete = false;
+			continue;
+		}
+
+		games.push_back(found->second);
+	}
+
+	// Outputs missing a Game would pass for a complete season
+	if (!complete) return false;
+
+	std::cout << "Merged " << games.size() << " games from " << shards
+		<< " shards" << std::endl;
+
+	if (dataStream != NULL) writeToDataFile(games, dataStream);
+
+	if (seasonStream != NULL) writeSeasonFile(season, &index, seasonStream);
+
+	return true;
+}
+
+bool runShardProcesses(std::string gamePath, std::string playPath,
+	std::vector<std::string> manifest, int shards, std::string shardDir) {
+
+	std::vector<pid_t> workers;
+
+	// Buffered output would otherwise be written by every child too
+	std::cout.flush();
+	std::cerr.flush();
+
+	for (int shard = 0; shard < shards; shard++) {
+
+		pid_t pid = fork();
+
+		if (pid < 0) {
+			std::cerr << "Could not start worker for shard " << shard
+				<< std::endl;
+			break;
+		}
+
+		if (pid == 0) {
+			std::ifstream gameFile(gamePath.c_str());
+			std::ifstream playFile(playPath.c_str());
+
+			bool done = gameFile.is_open() && playFile.is_open() &&
+				runShard(&gameFile, &playFile, manifest, shard, shards,
+					shardDir);
+
+			std::cout.flush();
+			_exit(done ? 0 : 1);
+		}
+
+		workers.push_back(pid);
+	}
+
+	bool succeeded = workers.size() == shards;
+
+	for (pid_t pid : workers) {
+
+		int status;
+
+		if (waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) ||
+			WEXITSTATUS(status) != 0) {
+			succeeded = false;
+		}
+	}
+
+	return succeeded;
+}
@@ -0,0 +1,63 @@
+/* Sharded Run Header */
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+// A sharded run splits the Games of a manifest (one Game ID per line, in
+// Data File order) into contiguous shards. Each worker process simulates
+// one shard and writes its partial output to the shard directory; a merge
+// then writes the usual outputs in manifest order. Workers only share the
+// directory, so they may run on any nodes that mount it.
+//
+// Partial output of shard i is written to shard_<i>.part, replaced
+// atomically once complete:
+//
+//   BBALL_SHARD <engine version> <shard> <shards>
+//   G <game id>            Then home and away Teams in cache file layout
+//   S <player id> <games> <points for> <points against> <off poss>
+//     <def poss>           Season partial, in order of first appearance
+//   E <games> <players>    End of a complete shard
+//
+// Shards are contiguous, so merging season partials in shard order keeps
+// the Player order of an unsharded season file.
+
+#ifndef SHARD_H_
+#define SHARD_H_
+
+#include "game.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+// Shard File Values
+#define SHARD_HEADER		"BBALL_SHARD"
+#define SHARD_MANIFEST		"manifest.txt"
+#define SHARD_PREFIX		"shard_"
+#define SHARD_EXT			".part"
+
+/// Read Game IDs of manifest, writing it from Game stream order if missing
+// - Returns an empty vector if the manifest can be neither read nor written
+std::vector<std::string> loadManifest(std::string manifestPath,
+	std::istream *gameStream);
+
+/// Path of the partial output of shard in shard directory
+std::string shardPath(std::string shardDir, int shard);
+
+/// Simulate the manifest Games of one shard and write its partial output
+bool runShard(std::istream *gameStream, std::istream *playStream,
+	std::vector<std::string> manifest, int shard, int shards,
+	std::string shardDir);
+
+/// Write Data File and season file from the partial output of every shard
+// - Returns false, writing nothing, if a shard is missing or incomplete or
+//   a manifest Game has no shard output
+bool mergeShards(std::vector<std::string> manifest, int shards,
+	std::string shardDir, std::ostream *dataStream,
+	std::ostream *seasonStream);
+
+/// Run every shard in its own local process, false if any of them failed
+bool runShardProcesses(std::string gamePath, std::string playPath,
+	std::vector<std::string> manifest, int shards, std::string shardDir);
+
+#endif // SHARD_H_
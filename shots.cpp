@@ -0,0 +1,131 @@
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#include "shots.hpp"
+#include "game.hpp"
+#include "season.hpp"
+
+#include <iomanip>
+
+
+static const char *SHOT_FAMILY_NAMES[SHOT_FAMILIES] = {
+	"Other", "Jump Shot", "Layup", "Dunk", "Hook Shot", "Tip Shot"
+};
+
+// Shot Table Constructor
+
+ShotTable::ShotTable(int slotCount) {
+
+	if (slotCount > COURT_MASK_SLOTS) slotCount = COURT_MASK_SLOTS;
+
+	slots = slotCount;
+
+	ShotTotals empty = { 0, 0, 0 };
+
+	grid.assign(slots * EVENT_CODE_ACTIONS, empty);
+}
+
+// Shot Functions
+
+void ShotTable::shot(int slot, int actionType, int points) {
+
+	if (slot < 0 || slot >= slots) return;
+
+	// Action types missing from Event_Codes.txt count as "No Shot"
+	if (actionType < 0 || actionType >= EVENT_CODE_ACTIONS) actionType = 0;
+
+	ShotTotals &totals = grid[slot * EVENT_CODE_ACTIONS + actionType];
+
+	totals.attempts++;
+
+	if (points > 0) {
+		totals.makes++;
+		totals.points += points;
+	}
+}
+
+// Shot Getters
+
+int ShotTable::getSlotCount() const {
+	return slots;
+}
+
+ShotTotals ShotTable::getShots(int slot, int actionType) const {
+	return grid[slot * EVENT_CODE_ACTIONS + actionType];
+}
+
+// Season Shot Output
+
+/* Add one Team's grid from a Game to season grid */
+static void addTeamShots(std::vector<ShotTotals> *season, PlayerIndex *index,
+	Team team, const ShotTable &table) {
+
+	ShotTotals empty = { 0, 0, 0 };
+
+	for (Player player : team.getRoster()) {
+
+		int slot = player.getSlot();
+
+		if (slot < 0 || slot >= table.getSlotCount()) continue;
+
+		int handle = index->intern(player.getPlayerID());
+
+		season->resize(index->size() * EVENT_CODE_ACTIONS, empty);
+
+		ShotTotals *row = &(*season)[handle * EVENT_CODE_ACTIONS];
+
+		for (int a = 0; a < EVENT_CODE_ACTIONS; a++) {
+
+			ShotTotals shots = table.getShots(slot, a);
+
+			row[a].attempts += shots.attempts;
+			row[a].makes += shots.makes;
+			row[a].points += shots.points;
+		}
+	}
+}
+
+void writeShotFile(std::vector<Game> *games, std::ostream *shotStream) {
+
+	PlayerIndex index;
+
+	std::vector<ShotTotals> season;
+
+	for (Game &game : *games) {
+		addTeamShots(&season, &index, game.getHomeTeam(), game.getHomeShots());
+		addTeamShots(&season, &index, game.getAwayTeam(), game.getAwayShots());
+	}
+
+	*shotStream << "\"Person_id\",\"Action_Type\",\"Description\",\"Family\","
+		<< "\"FGA\",\"FGM\",\"Points\",\"PtsPerShot\",\"ShotShare\""
+		<< std::endl;
+
+	for (int h = 0; h < index.size(); h++) {
+
+		ShotTotals *row = &season[h * EVENT_CODE_ACTIONS];
+
+		int attempts = 0;
+
+		for (int a = 0; a < EVENT_CODE_ACTIONS; a++) {
+			attempts += row[a].attempts;
+		}
+
+		for (int a = 0; a < EVENT_CODE_ACTIONS; a++) {
+
+			if (row[a].attempts == 0) continue;
+
+			const EventCode *code = findEventCode(MADE_SHOT, a);
+
+			const char *description = code ? code->actionName : "Unknown";
+			int family = code ? code->shotFamily : SHOT_NONE;
+
+			*shotStream << std::fixed << std::setprecision(3) << "\""
+				<< index.getPlayerID(h) << "\"," << a << ",\"" << description
+				<< "\",\"" << SHOT_FAMILY_NAMES[family] << "\","
+				<< row[a].attempts << "," << row[a].makes << ","
+				<< row[a].points << ","
+				<< (row[a].points / (double)row[a].attempts) << ","
+				<< (row[a].attempts / (double)attempts) << std::endl;
+		}
+	}
+}
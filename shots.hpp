@@ -0,0 +1,53 @@
+/* Shot Profile Header */
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#ifndef SHOTS_H_
+#define SHOTS_H_
+
+#include "codes.hpp"
+
+#include <iostream>
+#include <vector>
+
+
+class Game;
+
+/* Field goal attempts, makes and points for one slot and action type */
+struct ShotTotals {
+	int attempts;
+	int makes;
+	int points;
+};
+
+/* Dense slot by action type grid of field goals for one Team of a Game */
+class ShotTable {
+
+public:
+
+	ShotTable() { slots = 0; }; // Default
+
+	/// Construct empty grid for roster of slot count Players
+	ShotTable(int slotCount);
+
+	/// Shot Functions
+
+	/// Add field goal attempt, points is zero for a miss
+	void shot(int slot, int actionType, int points);
+
+	/// Shot Getters
+
+	int getSlotCount() const;
+
+	ShotTotals getShots(int slot, int actionType) const;
+
+private:
+
+	int slots;						// Roster slots in grid
+	std::vector<ShotTotals> grid;	// Slot s, action a at s * ACTIONS + a
+};
+
+/// Write season points per shot and shot share of every Player by action
+void writeShotFile(std::vector<Game> *games, std::ostream *shotStream);
+
+#endif // SHOTS_H_
@@ -0,0 +1,234 @@
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#include "stint.hpp"
+#include "game.hpp"
+#include "season.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+
+// Stint Functions
+
+void StintLog::start(uint64_t homeMask, uint64_t awayMask, int period,
+	int time) {
+
+	finish(period, time);
+
+	current.period = period;
+	current.startTime = time;
+	current.endTime = time;
+
+	current.homeMask = homeMask;
+	current.awayMask = awayMask;
+
+	current.homePossessions = 0;
+	current.awayPossessions = 0;
+
+	current.homePoints = 0;
+	current.awayPoints = 0;
+
+	open = true;
+}
+
+void StintLog::finish(int period, int time) {
+
+	if (!open) return;
+
+	open = false;
+
+	// Stint left open into the next period ran to the end of its own
+	if (period == current.period) current.endTime = time;
+	else current.endTime = 0;
+
+	// Subs at one stoppage leave empty stints between them
+	if (current.homePossessions == 0 && current.awayPossessions == 0 &&
+		current.homePoints == 0 && current.awayPoints == 0 &&
+		current.startTime == current.endTime) {
+		return;
+	}
+
+	stints.push_back(current);
+}
+
+void StintLog::homePossession() {
+	if (open) current.homePossessions++;
+}
+
+void StintLog::awayPossession() {
+	if (open) current.awayPossessions++;
+}
+
+void StintLog::homeScore(int points) {
+	if (open) current.homePoints += points;
+}
+
+void StintLog::awayScore(int points) {
+	if (open) current.awayPoints += points;
+}
+
+// Stint Getters
+
+const std::vector<Stint> &StintLog::getStints() {
+	return stints;
+}
+
+// Stint Output
+
+/* Player ID of every roster slot of Team */
+static std::vector<std::string> slotIDs(Team team) {
+
+	std::vector<std::string> ids(team.getTeamSize());
+
+	for (Player player : team.getRoster()) {
+		ids[player.getSlot()] = player.getPlayerID();
+	}
+
+	return ids;
+}
+
+/* Player IDs of court mask, padded or cut to STINT_COURT columns */
+static std::vector<std::string> courtIDs(uint64_t mask,
+	std::vector<std::string> ids) {
+
+	std::vector<std::string> court;
+
+	for (; mask != 0 && court.size() < STINT_COURT; mask &= mask - 1) {
+
+		int slot = lowestCourtSlot(mask);
+
+		if (slot < ids.size()) court.push_back(ids[slot]);
+	}
+
+	court.resize(STINT_COURT);
+
+	return court;
+}
+
+void writeStintFile(std::vector<Game> *games, std::ostream *stintStream) {
+
+	*stintStream << "\"Game_id\",\"Period\",\"StartTime\",\"EndTime\"";
+
+	for (int i = 1; i <= STINT_COURT; i++) *stintStream << ",\"Home" << i
+		<< "\"";
+	for (int i = 1; i <= STINT_COURT; i++) *stintStream << ",\"Away" << i
+		<< "\"";
+
+	*stintStream << ",\"HomePoss\",\"AwayPoss\",\"HomePts\",\"AwayPts\""
+		<< std::endl;
+
+	for (Game &game : *games) {
+
+		std::vector<std::string> homeIDs = slotIDs(game.getHomeTeam());
+		std::vector<std::string> awayIDs = slotIDs(game.getAwayTeam());
+
+		for (Stint stint : game.getStints()) {
+
+			*stintStream << "\"" << game.getGameID() << "\"," << stint.period
+				<< "," << stint.startTime << "," << stint.endTime;
+
+			for (std::string id : courtIDs(stint.homeMask, homeIDs)) {
+				*stintStream << ",\"" << id << "\"";
+			}
+			for (std::string id : courtIDs(stint.awayMask, awayIDs)) {
+				*stintStream << ",\"" << id << "\"";
+			}
+
+			*stintStream << "," << stint.homePossessions << ","
+				<< stint.awayPossessions << "," << stint.homePoints << ","
+				<< stint.awayPoints << std::endl;
+		}
+	}
+}
+
+/* Write fixed width, zero padded ID */
+static void writeID(std::ostream *stintStream, std::string id) {
+
+	char field[STINT_ID_LENGTH];
+
+	std::memset(field, 0, STINT_ID_LENGTH);
+	std::memcpy(field, id.data(), std::min((int)id.length(),
+		STINT_ID_LENGTH));
+
+	stintStream->write(field, STINT_ID_LENGTH);
+}
+
+/* Fill Player columns with handles of court mask */
+static void courtHandles(uint64_t mask, std::vector<int> handles,
+	uint32_t *columns) {
+
+	int count = 0;
+
+	for (; mask != 0 && count < STINT_COURT; mask &= mask - 1) {
+
+		int slot = lowestCourtSlot(mask);
+
+		if (slot < handles.size()) columns[count++] = handles[slot];
+	}
+
+	while (count < STINT_COURT) columns[count++] = NO_STINT_PLAYER;
+}
+
+bool writeStintTable(std::vector<Game> *games, std::ostream *stintStream) {
+
+	PlayerIndex index;
+
+	std::vector<StintRow> rows;
+
+	for (int g = 0; g < games->size(); g++) {
+
+		Game &game = (*games)[g];
+
+		std::vector<int> homeHandles, awayHandles;
+
+		for (std::string id : slotIDs(game.getHomeTeam())) {
+			homeHandles.push_back(index.intern(id));
+		}
+		for (std::string id : slotIDs(game.getAwayTeam())) {
+			awayHandles.push_back(index.intern(id));
+		}
+
+		for (Stint stint : game.getStints()) {
+
+			StintRow row;
+
+			row.game = g;
+			row.period = stint.period;
+			row.startTime = stint.startTime;
+			row.endTime = stint.endTime;
+
+			courtHandles(stint.homeMask, homeHandles, row.homePlayers);
+			courtHandles(stint.awayMask, awayHandles, row.awayPlayers);
+
+			row.homePossessions = stint.homePossessions;
+			row.awayPossessions = stint.awayPossessions;
+			row.homePoints = stint.homePoints;
+			row.awayPoints = stint.awayPoints;
+
+			rows.push_back(row);
+		}
+	}
+
+	StintHeader header;
+
+	header.magic = STINT_MAGIC;
+	header.version = STINT_VERSION;
+	header.gameCount = games->size();
+	header.playerCount = index.size();
+	header.stintCount = rows.size();
+
+	stintStream->write((const char *)&header, sizeof(header));
+
+	for (Game &game : *games) writeID(stintStream, game.getGameID());
+
+	for (int h = 0; h < index.size(); h++) {
+		writeID(stintStream, index.getPlayerID(h));
+	}
+
+	stintStream->write((const char *)rows.data(),
+		rows.size() * sizeof(StintRow));
+
+	return !stintStream->fail();
+}
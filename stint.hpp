@@ -0,0 +1,104 @@
+/* Stint Header */
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#ifndef STINT_H_
+#define STINT_H_
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+
+// Stint Table Values
+#define STINT_MAGIC		0x54534242	// "BBST"
+#define STINT_VERSION	1
+#define STINT_ID_LENGTH	40
+#define STINT_COURT		5			// Player columns per team
+#define NO_STINT_PLAYER	0xffffffff	// Empty Player column
+
+class Game;
+
+/* Stretch of a Game with the same ten Players on court */
+struct Stint {
+	int period;
+	int startTime;		// PC Time (tenth sec) when courts were set
+	int endTime;		// PC Time (tenth sec) when either court changed
+
+	uint64_t homeMask;	// Home court roster slots
+	uint64_t awayMask;	// Away court roster slots
+
+	int homePossessions;
+	int awayPossessions;
+
+	int homePoints;
+	int awayPoints;
+};
+
+/* Stints of one Game, split whenever either court changes */
+class StintLog {
+
+public:
+
+	StintLog() { open = false; }; // Default
+
+	/// Stint Functions
+
+	/// Close current stint and start one for the given courts and clock
+	void start(uint64_t homeMask, uint64_t awayMask, int period, int time);
+
+	/// Close current stint at the clock, dropping it if nothing happened
+	void finish(int period, int time);
+
+	void homePossession();
+	void awayPossession();
+
+	void homeScore(int points);
+	void awayScore(int points);
+
+	/// Stint Getters
+
+	const std::vector<Stint> &getStints();
+
+private:
+
+	Stint current;	// Stint being played
+	bool open;		// Current stint has been started
+
+	std::vector<Stint> stints;	// Closed stints in Game order
+};
+
+/* Stint table file layout */
+// - StintHeader, then gameCount and playerCount fixed width IDs, then
+//   stintCount StintRow in Game order
+struct StintHeader {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t gameCount;
+	uint32_t playerCount;
+	uint32_t stintCount;
+};
+
+/* One stint with Game and Players as indexes into the ID tables */
+struct StintRow {
+	uint32_t game;
+	int32_t period;
+	int32_t startTime;
+	int32_t endTime;
+
+	uint32_t homePlayers[STINT_COURT];
+	uint32_t awayPlayers[STINT_COURT];
+
+	int32_t homePossessions;
+	int32_t awayPossessions;
+	int32_t homePoints;
+	int32_t awayPoints;
+};
+
+/// Write every stint of every Game as CSV
+void writeStintFile(std::vector<Game> *games, std::ostream *stintStream);
+
+/// Write every stint of every Game as a dense binary table
+bool writeStintTable(std::vector<Game> *games, std::ostream *stintStream);
+
+#endif // STINT_H_
@@ -0,0 +1,422 @@
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#include "store.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+/* Copy ID into fixed width, zero padded field */
+static bool packID(std::string id, char *field) {
+
+	if (id.length() > STORE_ID_LENGTH) return false;
+
+	std::memset(field, 0, STORE_ID_LENGTH);
+	std::memcpy(field, id.data(), id.length());
+
+	return true;
+}
+
+/* Get segment number from file name, -1 if not a segment */
+static int segmentNumber(std::string name) {
+
+	std::string prefix = STORE_SEGMENT_NAME;
+	std::string ext = STORE_SEGMENT_EXT;
+
+	if (name.length() <= prefix.length() + ext.length()) return -1;
+	if (name.compare(0, prefix.length(), prefix) != 0) return -1;
+	if (name.compare(name.length() - ext.length(), ext.length(), ext) != 0) {
+		return -1;
+	}
+
+	std::string number = name.substr(prefix.length(),
+		name.length() - prefix.length() - ext.length());
+
+	for (char c : number) {
+		if (c < '0' || c > '9') return -1;
+	}
+
+	return std::atoi(number.c_str());
+}
+
+static std::string segmentPath(std::string dir, int number) {
+	return dir + "/" + STORE_SEGMENT_NAME + std::to_string(number) +
+		STORE_SEGMENT_EXT;
+}
+
+// Career Store Constructor
+
+CareerStore::CareerStore(std::string dir) {
+	directory = dir;
+	nextSegment = 0;
+
+	DIR *storeDir = opendir(directory.c_str());
+
+	if (storeDir == NULL) return;
+
+	std::vector<int> numbers;
+
+	struct dirent *entry;
+
+	while ((entry = readdir(storeDir)) != NULL) {
+		int number = segmentNumber(entry->d_name);
+
+		if (number >= 0) numbers.push_back(number);
+	}
+
+	closedir(storeDir);
+
+	std::sort(numbers.begin(), numbers.end());
+
+	for (int number : numbers) {
+		mapSegment(segmentPath(directory, number), number);
+		nextSegment = number + 1;
+	}
+
+	// A compacted segment supersedes every lower numbered one left behind
+	std::vector<StoreSegment> current;
+
+	for (StoreSegment segment : segments) {
+
+		while (!current.empty() &&
+			current.back().number >= (int)segment.header->firstSegment) {
+
+			superseded.push_back(current.back().number);
+
+			munmap(current.back().base, current.back().length);
+			current.pop_back();
+		}
+
+		current.push_back(segment);
+	}
+
+	segments = current;
+}
+
+CareerStore::~CareerStore() {
+	unmapSegments();
+}
+
+// Store Functions
+
+int CareerStore::getSegmentCount() {
+	return segments.size();
+}
+
+bool CareerStore::mapSegment(std::string path, int number) {
+
+	int fd = open(path.c_str(), O_RDONLY);
+
+	if (fd < 0) return false;
+
+	struct stat info;
+
+	if (fstat(fd, &info) != 0 || info.st_size < (off_t)sizeof(StoreHeader)) {
+		close(fd);
+		return false;
+	}
+
+	void *base = mmap(NULL, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+
+	close(fd);
+
+	if (base == MAP_FAILED) return false;
+
+	StoreSegment segment;
+
+	segment.number = number;
+	segment.base = base;
+	segment.length = info.st_size;
+
+	segment.header = (const StoreHeader *)base;
+
+	size_t expected = sizeof(StoreHeader) +
+		segment.header->playerCount * sizeof(StoreIndexEntry) +
+		segment.header->recordCount * sizeof(StoreRecord) +
+		segment.header->gameCount * sizeof(StoreGameEntry);
+
+	bool valid = segment.header->magic == STORE_MAGIC &&
+		segment.header->version == STORE_VERSION &&
+		expected == segment.length &&
+		segment.header->firstSegment <= (uint32_t)number;
+
+	if (valid) {
+		segment.index = (const StoreIndexEntry *)(segment.header + 1);
+		segment.records = (const StoreRecord *)(segment.index +
+			segment.header->playerCount);
+		segment.games = (const StoreGameEntry *)(segment.records +
+			segment.header->recordCount);
+
+		// Every Player's records must lie within the segment
+		for (uint32_t i = 0; i < segment.header->playerCount; i++) {
+			if ((uint64_t)segment.index[i].firstRecord +
+				segment.index[i].recordCount > segment.header->recordCount) {
+				valid = false;
+			}
+		}
+	}
+
+	if (!valid) {
+		std::cerr << "Skipping invalid store segment " << path << std::endl;
+
+		munmap(base, info.st_size);
+		return false;
+	}
+
+	segments.push_back(segment);
+
+	return true;
+}
+
+void CareerStore::unmapSegments() {
+	for (StoreSegment segment : segments) {
+		munmap(segment.base, segment.length);
+	}
+
+	segments.clear();
+}
+
+static bool pendingLess(const PendingRecord &a, const PendingRecord &b) {
+	return std::memcmp(a.playerID, b.playerID, STORE_ID_LENGTH) < 0;
+}
+
+/* Build pending record from Player counters */
+static bool makePending(Player player, std::string gameID,
+	PendingRecord *pending) {
+
+	if (!packID(player.getPlayerID(), pending->playerID) ||
+		!packID(gameID, pending->record.gameID)) {
+
+		std::cerr << "ID too long for store: " << gameID << ", "
+			<< player.getPlayerID() << std::endl;
+		return false;
+	}
+
+	pending->record.pointsFor = player.getPointsFor();
+	pending->record.pointsAgainst = player.getPointsAgainst();
+	pending->record.offPossessions = player.getOffPossessions();
+	pending->record.defPossessions = player.getDefPossessions();
+
+	return true;
+}
+
+static bool gameLess(const StoreGameEntry &entry, const char *gameID) {
+	return std::memcmp(entry.gameID, gameID, STORE_ID_LENGTH) < 0;
+}
+
+bool CareerStore::isReplaced(int s, const char *gameID) {
+
+	for (int later = s + 1; later < segments.size(); later++) {
+
+		const StoreGameEntry *begin = segments[later].games;
+		const StoreGameEntry *end = begin + segments[later].header->gameCount;
+
+		const StoreGameEntry *found = std::lower_bound(begin, end, gameID,
+			gameLess);
+
+		if (found != end &&
+			std::memcmp(found->gameID, gameID, STORE_ID_LENGTH) == 0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool CareerStore::appendGames(std::vector<Game> games) {
+
+	std::vector<PendingRecord> pending;
+
+	PendingRecord curr;
+
+	for (Game game : games) {
+		for (Player player : game.getHomeTeam().getRoster()) {
+			if (makePending(player, game.getGameID(), &curr)) {
+				pending.push_back(curr);
+			}
+		}
+		for (Player player : game.getAwayTeam().getRoster()) {
+			if (makePending(player, game.getGameID(), &curr)) {
+				pending.push_back(curr);
+			}
+		}
+	}
+
+	if (pending.empty()) return true;
+
+	return writeSegment(pending, false);
+}
+
+bool CareerStore::compact() {
+
+	if (segments.size() < 2) return true;
+
+	std::vector<PendingRecord> pending;
+
+	PendingRecord curr;
+
+	// Records of Games appended again are dropped, as lookup skips them
+	for (int s = 0; s < segments.size(); s++) {
+
+		const StoreSegment *segment = &segments[s];
+
+		for (uint32_t i = 0; i < segment->header->playerCount; i++) {
+
+			const StoreIndexEntry *entry = &segment->index[i];
+
+			std::memcpy(curr.playerID, entry->playerID, STORE_ID_LENGTH);
+
+			for (uint32_t r = 0; r < entry->recordCount; r++) {
+
+				curr.record = segment->records[entry->firstRecord + r];
+
+				if (!isReplaced(s, curr.record.gameID)) pending.push_back(curr);
+			}
+		}
+	}
+
+	std::vector<int> replaced;
+
+	for (StoreSegment segment : segments) replaced.push_back(segment.number);
+
+	if (!writeSegment(pending, true)) return false;
+
+	// Replaced segments go only once the compacted one is in place
+	superseded.insert(superseded.end(), replaced.begin(), replaced.end());
+
+	for (int number : superseded) {
+		std::remove(segmentPath(directory, number).c_str());
+	}
+
+	superseded.clear();
+
+	return true;
+}
+
+bool CareerStore::writeSegment(std::vector<PendingRecord> pending,
+	bool compacted) {
+
+	// Stable sort keeps each Player's Games in input order
+	std::stable_sort(pending.begin(), pending.end(), pendingLess);
+
+	std::vector<StoreIndexEntry> index;
+	std::vector<StoreRecord> records;
+
+	for (int i = 0; i < pending.size(); i++) {
+
+		if (index.empty() || std::memcmp(index.back().playerID,
+			pending[i].playerID, STORE_ID_LENGTH) != 0) {
+
+			StoreIndexEntry entry;
+
+			std::memcpy(entry.playerID, pending[i].playerID, STORE_ID_LENGTH);
+			entry.firstRecord = records.size();
+			entry.recordCount = 0;
+
+			index.push_back(entry);
+		}
+
+		index.back().recordCount++;
+		records.push_back(pending[i].record);
+	}
+
+	std::vector<StoreGameEntry> games(records.size());
+
+	for (int i = 0; i < records.size(); i++) {
+		std::memcpy(games[i].gameID, records[i].gameID, STORE_ID_LENGTH);
+	}
+
+	std::sort(games.begin(), games.end(),
+		[](const StoreGameEntry &a, const StoreGameEntry &b) {
+		return std::memcmp(a.gameID, b.gameID, STORE_ID_LENGTH) < 0;
+	});
+
+	games.erase(std::unique(games.begin(), games.end(),
+		[](const StoreGameEntry &a, const StoreGameEntry &b) {
+		return std::memcmp(a.gameID, b.gameID, STORE_ID_LENGTH) == 0;
+	}), games.end());
+
+	StoreHeader header;
+
+	header.magic = STORE_MAGIC;
+	header.version = STORE_VERSION;
+	header.playerCount = index.size();
+	header.recordCount = records.size();
+	header.firstSegment = compacted ? 0 : nextSegment;
+	header.gameCount = games.size();
+
+	mkdir(directory.c_str(), 0755);
+
+	// Write to temporary file, then rename so readers never see partial data
+	std::string path = segmentPath(directory, nextSegment);
+	std::string tmpPath = path + ".tmp";
+
+	std::ofstream segmentFile(tmpPath.c_str(), std::ios::binary);
+
+	if (!segmentFile.is_open()) return false;
+
+	segmentFile.write((const char *)&header, sizeof(header));
+	segmentFile.write((const char *)index.data(),
+		index.size() * sizeof(StoreIndexEntry));
+	segmentFile.write((const char *)records.data(),
+		records.size() * sizeof(StoreRecord));
+	segmentFile.write((const char *)games.data(),
+		games.size() * sizeof(StoreGameEntry));
+	segmentFile.close();
+
+	if (segmentFile.fail() || std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+		std::remove(tmpPath.c_str());
+		return false;
+	}
+
+	if (compacted) unmapSegments();
+
+	return mapSegment(path, nextSegment++);
+}
+
+static bool indexLess(const StoreIndexEntry &entry, const char *playerID) {
+	return std::memcmp(entry.playerID, playerID, STORE_ID_LENGTH) < 0;
+}
+
+std::vector<StoreRecord> CareerStore::lookup(std::string playerID) {
+
+	std::vector<StoreRecord> history;
+
+	char key[STORE_ID_LENGTH];
+
+	if (!packID(playerID, key)) return history;
+
+	for (int s = 0; s < segments.size(); s++) {
+
+		const StoreIndexEntry *begin = segments[s].index;
+		const StoreIndexEntry *end = begin + segments[s].header->playerCount;
+
+		const StoreIndexEntry *found = std::lower_bound(begin, end,
+			(const char *)key, indexLess);
+
+		if (found == end ||
+			std::memcmp(found->playerID, key, STORE_ID_LENGTH) != 0) {
+			continue;
+		}
+
+		const StoreRecord *first = segments[s].records + found->firstRecord;
+
+		// Games appended again are read from their latest segment
+		for (uint32_t r = 0; r < found->recordCount; r++) {
+			if (!isReplaced(s, first[r].gameID)) history.push_back(first[r]);
+		}
+	}
+
+	return history;
+}
@@ -0,0 +1,125 @@
+/* Career Store Header */
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#ifndef STORE_H_
+#define STORE_H_
+
+#include "game.hpp"
+#include "player.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+// Career Store File Values
+#define STORE_MAGIC			0x53434242	// "BBCS"
+#define STORE_VERSION		3
+#define STORE_ID_LENGTH		40
+#define STORE_SEGMENT_NAME	"careers_"
+#define STORE_SEGMENT_EXT	".bbs"
+
+/* Segment header at the start of every store file */
+struct StoreHeader {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t playerCount;
+	uint32_t recordCount;
+	uint32_t firstSegment;	// Lowest segment number whose records it holds
+	uint32_t gameCount;
+};
+
+/* Player index entry, sorted by Player ID within a segment */
+struct StoreIndexEntry {
+	char playerID[STORE_ID_LENGTH];
+	uint32_t firstRecord;
+	uint32_t recordCount;
+};
+
+/* Per-player, per-game counters */
+struct StoreRecord {
+	char gameID[STORE_ID_LENGTH];
+	int32_t pointsFor;
+	int32_t pointsAgainst;
+	int32_t offPossessions;
+	int32_t defPossessions;
+};
+
+/* Game ID entry, sorted, one for every Game a segment holds */
+struct StoreGameEntry {
+	char gameID[STORE_ID_LENGTH];
+};
+
+/* Pair of packed Player ID and record, sorted by Player ID */
+struct PendingRecord {
+	char playerID[STORE_ID_LENGTH];
+	StoreRecord record;
+};
+
+/* Read-only mapping of one store segment */
+struct StoreSegment {
+	int number;
+
+	void *base;
+	size_t length;
+
+	const StoreHeader *header;
+	const StoreIndexEntry *index;
+	const StoreRecord *records;
+	const StoreGameEntry *games;
+};
+
+/* Append-only on-disk store of Player counters across Games */
+// - Each append writes a new segment file and never touches earlier ones.
+//   Lookups binary search every mapped segment and merge them in append
+//   order. A Game appended again replaces its records in older segments.
+// - Compaction, only on request, writes one segment holding the current
+//   records, which supersedes all lower numbered segments.
+class CareerStore {
+
+public:
+
+	/// Open (and map) all segments in store directory
+	// - The directory is only created by the first append
+	CareerStore(std::string dir);
+	~CareerStore();
+
+	/// Store Functions
+
+	/// Append one segment holding every roster Player of every Game
+	bool appendGames(std::vector<Game> games);
+
+	/// Return current records of Player in append order
+	// - Records of a Game appended again are taken from the latest segment
+	std::vector<StoreRecord> lookup(std::string playerID);
+
+	/// Merge every segment into one holding only current records
+	bool compact();
+
+	int getSegmentCount();
+
+private:
+
+	CareerStore(const CareerStore &);
+	CareerStore &operator=(const CareerStore &);
+
+	bool mapSegment(std::string path, int number);
+	void unmapSegments();
+
+	/// Write pending records as the next segment and map it
+	bool writeSegment(std::vector<PendingRecord> pending, bool compacted);
+
+	/// Checks if a segment after segments[s] holds Game again
+	bool isReplaced(int s, const char *gameID);
+
+	std::string directory;	// Directory holding segment files
+
+	int nextSegment;		// Number given to next appended segment
+
+	std::vector<StoreSegment> segments;	// Mapped segments in append order
+
+	std::vector<int> superseded;	// Segment files replaced by a compaction
+};
+
+#endif // STORE_H_
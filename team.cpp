@@ -3,6 +3,21 @@
 
 #include "team.hpp"
 
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+
+int lowestCourtSlot(uint64_t mask) {
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward64(&index, mask);
+	return index;
+#else
+	return __builtin_ctzll(mask);
+#endif
+}
+
 // Team Constructor
 
 Team::Team(std::string tid) {
@@ -11,6 +26,8 @@ Team::Team(std::string tid) {
 
 	offPossessions = 0;
 	defPossessions = 0;
+
+	courtMask = 0;
 }
 
 // Get Team Variables
@@ -31,6 +48,40 @@ std::vector<Player> Team::getBench() {
 	return bench;
 }
 
+uint64_t Team::getLineupKey() {
+
+	int slots[LINEUP_MAX_PLAYERS];
+	int count = 0;
+
+	for (int i = 0; i < court.size() && count < LINEUP_MAX_PLAYERS; i++) {
+
+		int slot = court[i].getSlot();
+
+		if (slot < 0 || slot >= LINEUP_SLOT_LIMIT) continue;
+
+		// Insertion sort, court never holds more than a few Players
+		int j = count++;
+
+		while (j > 0 && slots[j - 1] > slot) {
+			slots[j] = slots[j - 1];
+			j--;
+		}
+		slots[j] = slot;
+	}
+
+	uint64_t key = 0;
+
+	for (int i = 0; i < count; i++) {
+		key = (key << 8) | (uint64_t)(slots[i] + 1);
+	}
+
+	return key;
+}
+
+uint64_t Team::getCourtMask() {
+	return courtMask;
+}
+
 // Team Functions
 
 int Team::getTeamSize() {
@@ -51,6 +102,8 @@ int Team::getDefPossessions() {
 
 // Add Player p to Team roster
 void Team::addPlayer(Player p) {
+	p.setSlot(roster.size());
+
 	roster.push_back(p);
 }
 
@@ -58,9 +111,12 @@ void Team::addToCourt(Player p) {
 
 	for (Player player : roster) {
 		if (player == p) {
+			p.setSlot(player.getSlot());
 			court.push_back(p);
 		}
 	}
+
+	updateCourtMask();
 }
 
 void Team::addToBench(Player p) {
@@ -83,6 +139,8 @@ void Team::removeFromBench(Player p) {
 
 void Team::clearCourt() {
 	court.clear();
+
+	updateCourtMask();
 }
 
 void Team::score(int points) {
@@ -199,6 +257,8 @@ void Team::substitute(Player out, Player in) {
 
 	bench = newBench;
 	court = newCourt;
+
+	updateCourtMask();
 }
 
 // Team Checks
@@ -213,6 +273,16 @@ bool Team::hasPlayer(Player p) {
 	return false;
 }
 
+int Team::findSlot(Player p) {
+	for (Player player : roster) {
+		if (player == p) {
+			return player.getSlot();
+		}
+	}
+
+	return NO_SLOT;
+}
+
 bool Team::isOnCourt(Player p) {
 	for (Player player : court) {
 		if (player == p) {
@@ -259,6 +329,96 @@ void Team::updateRoster() {
 	roster = newRoster;
 }
 
+/* Counters of Player with its roster slot */
+static PlayerState savePlayer(Player player) {
+
+	PlayerState state;
+
+	state.slot = player.getSlot();
+	state.pointsFor = player.getPointsFor();
+	state.pointsAgainst = player.getPointsAgainst();
+	state.offPossessions = player.getOffPossessions();
+	state.defPossessions = player.getDefPossessions();
+	state.active = player.isActive();
+
+	return state;
+}
+
+/* Roster Player of slot with saved counters */
+static Player restorePlayer(std::vector<Player> *roster, PlayerState state) {
+
+	Player player;
+
+	for (Player rosterPlayer : *roster) {
+		if (rosterPlayer.getSlot() == state.slot) {
+			player = rosterPlayer;
+			break;
+		}
+	}
+
+	player.setCounters(state.pointsFor, state.pointsAgainst,
+		state.offPossessions, state.defPossessions);
+
+	if (state.active) player.activate();
+	else player.deactivate();
+
+	return player;
+}
+
+TeamState Team::saveState() {
+
+	TeamState state;
+
+	state.score = gameScore;
+	state.offPossessions = offPossessions;
+	state.defPossessions = defPossessions;
+
+	for (Player player : court) state.court.push_back(savePlayer(player));
+	for (Player player : bench) state.bench.push_back(savePlayer(player));
+
+	return state;
+}
+
+void Team::restoreState(TeamState state) {
+
+	gameScore = state.score;
+	offPossessions = state.offPossessions;
+	defPossessions = state.defPossessions;
+
+	court.clear();
+	bench.clear();
+
+	for (PlayerState player : state.court) {
+		court.push_back(restorePlayer(&roster, player));
+	}
+	for (PlayerState player : state.bench) {
+		bench.push_back(restorePlayer(&roster, player));
+	}
+
+	updateCourtMask();
+}
+
+void Team::setCounters(int score, int op, int dp) {
+	gameScore = score;
+
+	offPossessions = op;
+	defPossessions = dp;
+}
+
+void Team::updateCourtMask() {
+
+	courtMask = 0;
+
+	for (int i = 0; i < court.size(); i++) {
+
+		int slot = court[i].getSlot();
+
+		if (slot >= 0 && slot < COURT_MASK_SLOTS) {
+			courtMask |= (uint64_t)1 << slot;
+		}
+	}
+}
+
 // Team Operators
 
 bool Team::operator==(Team t) {
@@ -7,15 +7,48 @@
 
 #include "player.hpp"
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
+// Lineup Key Values
+#define LINEUP_MAX_PLAYERS	8	// One byte per Player in 64 bit key
+#define LINEUP_SLOT_LIMIT	255	// Slots stored as slot + 1, zero is empty
+
+// Roster slots tracked by the court bitmask
+#define COURT_MASK_SLOTS	64
+
+/// Lowest roster slot in court mask, mask must not be zero
+int lowestCourtSlot(uint64_t mask);
+
+/* Counters of one court or bench Player, identified by roster slot */
+struct PlayerState {
+	int slot;	// NO_SLOT for a Player missing from the roster
+
+	int pointsFor;
+	int pointsAgainst;
+	int offPossessions;
+	int defPossessions;
+
+	bool active;
+};
+
+/* Score, court and bench of a Team during a Game, without Player IDs */
+struct TeamState {
+	int score;
+	int offPossessions;
+	int defPossessions;
+
+	std::vector<PlayerState> court;	// In court order
+	std::vector<PlayerState> bench;	// In bench order
+};
+
 /* Represents Team with Players */
 class Team {
 
 public:
 
-	Team() {}; // Default
+	Team() { courtMask = 0; }; // Default
 
 	/// Construct Team with ID
 	Team(std::string tid);
@@ -35,6 +68,12 @@ public:
 	std::vector<Player> getCourt();
 	std::vector<Player> getBench();
 
+	/// Sorted roster slots of court Players packed one per byte
+	uint64_t getLineupKey();
+
+	/// Bit per roster slot of court Players
+	uint64_t getCourtMask();
+
 	/// Team Functions
 
 	void addPlayer(Player p);
@@ -59,11 +98,23 @@ public:
 
 	bool hasPlayer(Player p);
 
+	/// Roster slot of Player, NO_SLOT if not on roster
+	int findSlot(Player p);
+
 	bool isOnCourt(Player p);
 	bool isOnBench(Player p);
 
 	void updateRoster();
 
+	/// Restore score and possessions saved from an earlier simulation
+	void setCounters(int score, int op, int dp);
+
+	/// Save score, court and bench with every court and bench Player counter
+	TeamState saveState();
+
+	/// Restore state saved by saveState from this Team's roster
+	void restoreState(TeamState state);
+
 	/// Team Operators
 
 	bool operator==(Team t);
@@ -82,6 +133,10 @@ private:
 	std::vector<Player> court;	// Vector of Players in Game
 	std::vector<Player> bench;	// Vector of Non-playing Players in Game
 
+	uint64_t courtMask;			// Roster slots of court Players
+
+	void updateCourtMask();
+
 };
 
 #endif // TEAM_H_
\ No newline at end of file
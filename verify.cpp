@@ -0,0 +1,399 @@
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#include "verify.hpp"
+
+#include "engine.hpp"
+
+#include <algorithm>
+#include <string>
+
+
+/* Report every roster Player whose counters differ, return mismatches */
+static int compareTeams(std::string context, Team expected, Team actual,
+	std::ostream *report) {
+
+	std::vector<Player> want = expected.getRoster();
+	std::vector<Player> got = actual.getRoster();
+
+	if (want.size() != got.size()) {
+		*report << context << ": " << expected.getTeamID()
+			<< " roster sizes differ" << std::endl;
+		return 1;
+	}
+
+	int mismatches = 0;
+
+	if (expected.getScore() != actual.getScore()) {
+		*report << context << ": " << expected.getTeamID() << " score "
+			<< actual.getScore() << ", expected " << expected.getScore()
+			<< std::endl;
+		mismatches++;
+	}
+
+	for (int i = 0; i < want.size(); i++) {
+
+		if (want[i].getPointsFor() == got[i].getPointsFor() &&
+			want[i].getPointsAgainst() == got[i].getPointsAgainst() &&
+			want[i].getOffPossessions() == got[i].getOffPossessions() &&
+			want[i].getDefPossessions() == got[i].getDefPossessions()) {
+			continue;
+		}
+
+		*report << context << ": " << want[i].getPlayerID() << " counters "
+			<< got[i].getPointsFor() << "/" << got[i].getPointsAgainst()
+			<< "/" << got[i].getOffPossessions() << "/"
+			<< got[i].getDefPossessions() << ", expected "
+			<< want[i].getPointsFor() << "/" << want[i].getPointsAgainst()
+			<< "/" << want[i].getOffPossessions() << "/"
+			<< want[i].getDefPossessions() << std::endl;
+		mismatches++;
+	}
+
+	return mismatches;
+}
+
+/* Simulate a read Game from its first Event up to index end */
+static Game replayTo(Game game, int end) {
+
+	game.startSimulation();
+
+	while (game.getSimulated() < end) game.simulateNext();
+
+	game.updateRosters();
+
+	return game;
+}
+
+int verifySeek(std::vector<Game> *games, std::ostream *report) {
+
+	int mismatches = 0;
+
+	for (Game &read : *games) {
+
+		std::vector<Event> events = read.getGameEvents();
+
+		if (events.empty()) continue;
+
+		Game played = read;
+
+		played.simulateGame();
+
+		std::vector<int> checked;
+
+		for (int i = 0; i < events.size(); i += VERIFY_SEEK_STRIDE) {
+			checked.push_back(i);
+		}
+		checked.push_back(events.size() - 1);
+
+		for (int i : checked) {
+
+			int period = events[i].getPeriod();
+			int pcTime = events[i].getPCTime();
+
+			// Seek includes every Event on the clock, events are sorted
+			int end = i;
+
+			while (end < events.size() && events[end].getPeriod() == period &&
+				events[end].getPCTime() >= pcTime) {
+				end++;
+			}
+
+			std::string context = "Seek " + read.getGameID() + " period " +
+				std::to_string(period) + " at " + std::to_string(pcTime);
+
+			GameState state;
+
+			if (!played.seek(period, pcTime, &state)) {
+				*report << context << ": game was not simulated" << std::endl;
+				mismatches++;
+				break;
+			}
+
+			Game replay = replayTo(read, end);
+
+			mismatches += compareTeams(context, replay.getHomeTeam(),
+				state.homeTeam, report);
+			mismatches += compareTeams(context, replay.getAwayTeam(),
+				state.awayTeam, report);
+		}
+	}
+
+	return mismatches;
+}
+
+/* Sample corrections of a Game, touching up to three of its periods */
+static std::vector<EventCorrection> sampleCorrections(
+	std::vector<Event> events) {
+
+	std::vector<EventCorrection> corrections;
+
+	int lastPeriod = events.back().getPeriod();
+	int lastNumber = 0;
+
+	for (Event ev : events) {
+		lastNumber = std::max(lastNumber, ev.getEventNumber());
+	}
+
+	bool deleted = false, amended = false, inserted = false;
+
+	for (Event ev : events) {
+
+		EventCorrection correction;
+
+		correction.eventNumber = ev.getEventNumber();
+
+		if (!deleted && ev.getPeriod() == 2 && ev.isTurnover()) {
+			correction.kind = EVENT_DELETE;
+			correction.event = ev;
+
+			deleted = true;
+		}
+		else if (!amended && ev.getPeriod() == lastPeriod &&
+			ev.isMadeShot() && ev.getOption() == TWO_POINTS) {
+
+			correction.kind = EVENT_AMEND;
+			correction.event = Event(ev.getEventNumber(), ev.getEventType(),
+				ev.getPeriod(), ev.getActionType(), ev.getWCTime(),
+				ev.getPCTime(), THREE_POINTS, ev.getPlayer1(),
+				ev.getPlayer2(), ev.getPlayer3(), ev.getTeam());
+
+			amended = true;
+		}
+		else if (!inserted && ev.getPeriod() == 3 && ev.isFoul()) {
+			correction.kind = EVENT_INSERT;
+			correction.event = Event(++lastNumber, ev.getEventType(),
+				ev.getPeriod(), ev.getActionType(), ev.getWCTime(),
+				ev.getPCTime(), ev.getOption(), ev.getPlayer1(),
+				ev.getPlayer2(), ev.getPlayer3(), ev.getTeam());
+
+			inserted = true;
+		}
+		else continue;
+
+		corrections.push_back(correction);
+	}
+
+	return corrections;
+}
+
+/* Apply corrections to a copy of the Events, as a corrected Play File */
+static std::vector<Event> applyCorrections(std::vector<Event> events,
+	std::vector<EventCorrection> corrections) {
+
+	for (EventCorrection correction : corrections) {
+
+		if (correction.kind == EVENT_INSERT) {
+			events.push_back(correction.event);
+			continue;
+		}
+
+		for (int i = 0; i < events.size(); i++) {
+
+			if (events[i].getEventNumber() != correction.eventNumber) continue;
+
+			if (correction.kind == EVENT_DELETE) {
+				events.erase(events.begin() + i);
+			}
+			else events[i] = correction.event;
+
+			break;
+		}
+	}
+
+	return events;
+}
+
+/* Report deltas that differ from the change between two Teams */
+static int compareDeltas(std::string context, Team before, Team after,
+	std::vector<CounterDelta> deltas, std::ostream *report) {
+
+	int mismatches = 0;
+
+	for (Player old : before.getRoster()) {
+
+		CounterDelta want = { old.getPlayerID(), before.getTeamID(), 0, 0, 0,
+			0 };
+
+		for (Player now : after.getRoster()) {
+
+			if (!(now == old)) continue;
+
+			want.pointsFor = now.getPointsFor() - old.getPointsFor();
+			want.pointsAgainst = now.getPointsAgainst() -
+				old.getPointsAgainst();
+			want.offPossessions = now.getOffPossessions() -
+				old.getOffPossessions();
+			want.defPossessions = now.getDefPossessions() -
+				old.getDefPossessions();
+			break;
+		}
+
+		// Unchanged Players are left out of deltas
+		CounterDelta got = { want.playerID, want.teamID, 0, 0, 0, 0 };
+
+		for (CounterDelta delta : deltas) {
+			if (delta.playerID == want.playerID &&
+				delta.teamID == want.teamID) {
+				got = delta;
+			}
+		}
+
+		if (want.pointsFor == got.pointsFor &&
+			want.pointsAgainst == got.pointsAgainst &&
+			want.offPossessions == got.offPossessions &&
+			want.defPossessions == got.defPossessions) {
+			continue;
+		}
+
+		*report << context << ": " << want.playerID << " delta "
+			<< got.pointsFor << "/" << got.pointsAgainst << "/"
+			<< got.offPossessions << "/" << got.defPossessions
+			<< ", expected " << want.pointsFor << "/" << want.pointsAgainst
+			<< "/" << want.offPossessions << "/" << want.defPossessions
+			<< std::endl;
+		mismatches++;
+	}
+
+	return mismatches;
+}
+
+int verifyAmend(std::vector<Game> *games, std::ostream *report) {
+
+	int mismatches = 0;
+
+	for (Game &read : *games) {
+
+		std::vector<Event> events = read.getGameEvents();
+
+		if (events.empty()) continue;
+
+		std::vector<EventCorrection> corrections = sampleCorrections(events);
+
+		if (corrections.empty()) continue;
+
+		std::string context = "Amend " + read.getGameID();
+
+		Game played = read;
+
+		played.simulateGame();
+		played.updateRosters();
+
+		Game amended = played;
+
+		std::vector<CounterDelta> deltas;
+
+		if (amended.amendEvents(corrections, &deltas) == 0) {
+			*report << context << ": corrections were not applied"
+				<< std::endl;
+			mismatches++;
+			continue;
+		}
+
+		Game corrected = read;
+
+		corrected.clearEvents();
+
+		for (Event ev : applyCorrections(events, corrections)) {
+			corrected.addEvent(ev);
+		}
+
+		corrected.sortEvents();
+		corrected.simulateGame();
+		corrected.updateRosters();
+
+		mismatches += compareDeltas(context, played.getHomeTeam(),
+			corrected.getHomeTeam(), deltas, report);
+		mismatches += compareDeltas(context, played.getAwayTeam(),
+			corrected.getAwayTeam(), deltas, report);
+
+		mismatches += compareTeams(context, corrected.getHomeTeam(),
+			amended.getHomeTeam(), report);
+		mismatches += compareTeams(context, corrected.getAwayTeam(),
+			amended.getAwayTeam(), report);
+	}
+
+	return mismatches;
+}
+
+int verifyLateEvents(std::vector<Game> *games, std::ostream *report) {
+
+	int mismatches = 0;
+
+	for (Game &read : *games) {
+
+		std::vector<Event> events = read.getGameEvents();
+
+		if (events.empty()) continue;
+
+		int lastPeriod = events.back().getPeriod();
+
+		int start = 0;
+
+		while (events[start].getPeriod() < lastPeriod) start++;
+
+		// A made shot past the middle of the period arrives late
+		int late = start + (events.size() - start) / 2;
+
+		while (late < events.size() && !events[late].isMadeShot()) late++;
+
+		if (late == events.size()) continue;
+
+		std::string context = "Late event " + read.getGameID() + " " +
+			std::to_string(events[late].getEventNumber());
+
+		Game played = read;
+
+		played.simulateGame();
+		played.updateRosters();
+
+		Game live = read;
+
+		live.clearEvents();
+
+		for (int i = 0; i < events.size(); i++) {
+			if (i != late) live.addEvent(events[i]);
+		}
+
+		live.startSimulation();
+		live.advance(true);
+
+		if (!live.insertLateEvent(events[late])) {
+			*report << context << ": no snapshot to rewind to" << std::endl;
+			mismatches++;
+			continue;
+		}
+
+		// Period start is the same index with or without the late Event
+		bool rewound = events[start].isStartPeriod() ?
+			live.getSimulated() == start : live.getSimulated() <= start;
+
+		if (!rewound) {
+			*report << context << ": rewound to event " << live.getSimulated()
+				<< ", period starts at " << start << std::endl;
+			mismatches++;
+		}
+
+		live.advance(true);
+		live.finishSimulation();
+		live.updateRosters();
+
+		mismatches += compareTeams(context, played.getHomeTeam(),
+			live.getHomeTeam(), report);
+		mismatches += compareTeams(context, played.getAwayTeam(),
+			live.getAwayTeam(), report);
+	}
+
+	return mismatches;
+}
+
+int verifyGames(std::istream *gameStream, std::istream *playStream,
+	std::ostream *report) {
+
+	std::vector<Game> games = makeRosters(gameStream);
+
+	games = getGameEvents(games, playStream);
+
+	return verifySeek(&games, report) + verifyAmend(&games, report) +
+		verifyLateEvents(&games, report);
+}
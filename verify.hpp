@@ -0,0 +1,43 @@
+/* Simulation Verification Header */
+// Author: Kevin M. Smith <kmsmith3@vt.edu>
+// Version: June 2, 2019 <v2.0>
+
+#ifndef VERIFY_H_
+#define VERIFY_H_
+
+#include "game.hpp"
+
+#include <iostream>
+#include <vector>
+
+
+// Verification Values
+#define VERIFY_SEEK_STRIDE	16	// Events between seek clocks checked
+
+/// Compare Game::seek against a replay of every Event from the start
+// - Checks the clock of every VERIFY_SEEK_STRIDE-th Event and of the last
+// - Games must be read but not simulated. Every mismatch is written to
+//   report, returns the number of mismatches.
+int verifySeek(std::vector<Game> *games, std::ostream *report);
+
+/// Compare Game::amendEvents against a full simulation of corrected Events
+// - Each Game gets a deleted turnover, a made two amended to a three and a
+//   repeated foul, in its second, last and third periods where present.
+//   Deltas and Teams after amending must match the corrected simulation.
+// - Games must be read but not simulated, returns the number of mismatches
+int verifyAmend(std::vector<Game> *games, std::ostream *report);
+
+/// Compare Game::insertLateEvent against a simulation of Events in order
+// - Each Game is simulated to the end without one made shot of its last
+//   period, which then arrives late. It must rewind to the snapshot at the
+//   start of that period and finish with the Teams of an in-order run.
+// - Games must be read but not simulated, returns the number of mismatches
+int verifyLateEvents(std::vector<Game> *games, std::ostream *report);
+
+/// Read every Game in Game and Play streams and run every check on them
+// - Returns the number of mismatches, zero if incremental simulation agrees
+//   with full re-simulation
+int verifyGames(std::istream *gameStream, std::istream *playStream,
+	std::ostream *report);
+
+#endif // VERIFY_H_